@@ -89,16 +89,32 @@ void BoardShim::log_message (int log_level, const char *format, ...)
 /////// data acquisition methods /////////
 //////////////////////////////////////////
 
+// cached handle is stale if session was released and prepared again by another BoardShim or by
+// methods with json params, in this case it's resolved again and method is called once more
+template <typename Func> int BoardShim::call_by_handle (Func func)
+{
+    bool is_cached = (session_handle >= 0);
+    int res = func (get_handle ());
+    if ((res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR) && (is_cached))
+    {
+        session_handle = -1;
+        res = func (get_handle ());
+    }
+    return res;
+}
+
 BoardShim::BoardShim (int board_id, struct BrainFlowInputParams params)
 {
     serialized_params = params_to_string (params);
     this->params = params;
     this->board_id = board_id;
+    session_handle = -1;
 }
 
 void BoardShim::prepare_session ()
 {
-    int res = ::prepare_session (board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = ::prepare_session_handle (
+        &session_handle, board_id, const_cast<char *> (serialized_params.c_str ()));
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to prepare session", res);
@@ -118,8 +134,9 @@ bool BoardShim::is_prepared ()
 
 void BoardShim::start_stream (int buffer_size, char *streamer_params)
 {
-    int res = ::start_stream (
-        buffer_size, streamer_params, board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle ([&] (int handle) {
+        return ::start_stream_by_handle (buffer_size, streamer_params, handle);
+    });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to start stream", res);
@@ -128,7 +145,7 @@ void BoardShim::start_stream (int buffer_size, char *streamer_params)
 
 void BoardShim::stop_stream ()
 {
-    int res = ::stop_stream (board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle ([&] (int handle) { return ::stop_stream_by_handle (handle); });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to stop stream", res);
@@ -137,7 +154,8 @@ void BoardShim::stop_stream ()
 
 void BoardShim::release_session ()
 {
-    int res = ::release_session (board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle ([&] (int handle) { return ::release_session_by_handle (handle); });
+    session_handle = -1;
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to release session", res);
@@ -147,8 +165,8 @@ void BoardShim::release_session ()
 int BoardShim::get_board_data_count ()
 {
     int data_count = 0;
-    int res = ::get_board_data_count (
-        &data_count, board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle (
+        [&] (int handle) { return ::get_board_data_count_by_handle (&data_count, handle); });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to get board data count", res);
@@ -156,13 +174,29 @@ int BoardShim::get_board_data_count ()
     return data_count;
 }
 
+bool BoardShim::wait_for_board_data (int min_samples, int timeout_ms)
+{
+    int res = call_by_handle ([&] (int handle) {
+        return ::wait_for_board_data_by_handle (min_samples, timeout_ms, handle);
+    });
+    if (res == (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR)
+    {
+        return false;
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to wait for board data", res);
+    }
+    return true;
+}
+
 double **BoardShim::get_board_data (int *num_data_points)
 {
     int num_samples = get_board_data_count ();
     int num_data_channels = get_num_rows (get_board_id ());
     double *buf = new double[num_samples * num_data_channels];
-    int res = ::get_board_data (
-        num_samples, buf, board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle (
+        [&] (int handle) { return ::get_board_data_by_handle (num_samples, buf, handle); });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         delete[] buf;
@@ -184,8 +218,9 @@ double **BoardShim::get_current_board_data (int num_samples, int *num_data_point
 {
     int num_data_channels = BoardShim::get_num_rows (get_board_id ());
     double *buf = new double[num_samples * num_data_channels];
-    int res = ::get_current_board_data (num_samples, buf, num_data_points, board_id,
-        const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle ([&] (int handle) {
+        return ::get_current_board_data_by_handle (num_samples, buf, num_data_points, handle);
+    });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         delete[] buf;
@@ -207,8 +242,9 @@ std::string BoardShim::config_board (char *config)
 {
     int response_len = 0;
     char response[8192];
-    int res = ::config_board (
-        config, response, &response_len, board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle ([&] (int handle) {
+        return ::config_board_by_handle (config, response, &response_len, handle);
+    });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to config board", res);
@@ -219,13 +255,136 @@ std::string BoardShim::config_board (char *config)
 
 void BoardShim::insert_marker (double value)
 {
-    int res = ::insert_marker (value, board_id, const_cast<char *> (serialized_params.c_str ()));
+    int res = call_by_handle (
+        [&] (int handle) { return ::insert_marker_by_handle (value, handle); });
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to insert marker", res);
     }
 }
 
+void BoardShim::insert_marker (double value, double timestamp)
+{
+    int res = call_by_handle ([&] (int handle) {
+        return ::insert_marker_with_timestamp_by_handle (value, timestamp, handle);
+    });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to insert marker", res);
+    }
+}
+
+void BoardShim::get_streamer_stats (
+    int streamer_index, int *queue_depth, int *max_queue_depth, int *num_dropped)
+{
+    int res = call_by_handle ([&] (int handle) {
+        return ::get_streamer_stats_by_handle (
+            streamer_index, queue_depth, max_queue_depth, num_dropped, handle);
+    });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get streamer stats", res);
+    }
+}
+
+void BoardShim::add_reader_cursor (char *cursor_name)
+{
+    int res = call_by_handle (
+        [&] (int handle) { return ::add_reader_cursor_by_handle (cursor_name, handle); });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to add reader cursor", res);
+    }
+}
+
+void BoardShim::remove_reader_cursor (char *cursor_name)
+{
+    int res = call_by_handle (
+        [&] (int handle) { return ::remove_reader_cursor_by_handle (cursor_name, handle); });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to remove reader cursor", res);
+    }
+}
+
+double **BoardShim::get_board_data_since (char *cursor_name, int *num_data_points)
+{
+    int data_count = 0;
+    int num_lost = 0;
+    get_reader_cursor_stats (cursor_name, &data_count, &num_lost);
+    int num_data_channels = get_num_rows (get_board_id ());
+    double *buf = new double[data_count * num_data_channels];
+    int num_samples = 0;
+    int res = call_by_handle ([&] (int handle) {
+        return ::get_board_data_since_by_handle (
+            cursor_name, data_count, buf, &num_samples, handle);
+    });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] buf;
+        throw BrainFlowException ("failed to get board data since cursor", res);
+    }
+
+    double **output_buf = new double *[num_data_channels];
+    for (int i = 0; i < num_data_channels; i++)
+    {
+        output_buf[i] = new double[num_samples];
+    }
+    reshape_data (num_samples, buf, output_buf);
+    delete[] buf;
+    *num_data_points = num_samples;
+    return output_buf;
+}
+
+void BoardShim::get_reader_cursor_stats (char *cursor_name, int *data_count, int *num_lost)
+{
+    int res = call_by_handle ([&] (int handle) {
+        return ::get_reader_cursor_stats_by_handle (cursor_name, data_count, num_lost, handle);
+    });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get reader cursor stats", res);
+    }
+}
+
+int BoardShim::subscribe_board_data (
+    board_data_callback callback, void *user_data, int batch_size, int max_delay_ms)
+{
+    int subscription_id = -1;
+    int res = call_by_handle ([&] (int handle) {
+        return ::subscribe_board_data_by_handle (
+            callback, user_data, batch_size, max_delay_ms, &subscription_id, handle);
+    });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to subscribe to board data", res);
+    }
+    return subscription_id;
+}
+
+void BoardShim::unsubscribe_board_data (int subscription_id)
+{
+    int res = call_by_handle (
+        [&] (int handle) { return ::unsubscribe_board_data_by_handle (subscription_id, handle); });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to unsubscribe from board data", res);
+    }
+}
+
+void BoardShim::get_subscription_stats (
+    int subscription_id, int *lag, int *max_lag, int *num_dropped)
+{
+    int res = call_by_handle ([&] (int handle) {
+        return ::get_subscription_stats_by_handle (
+            subscription_id, lag, max_lag, num_dropped, handle);
+    });
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get subscription stats", res);
+    }
+}
+
 // for better user experience and consistency accross bindings we return 2d array from user api, we
 // can not do it directly in low level api because some languages can not pass multidim array to C++
 void BoardShim::reshape_data (int num_data_points, double *linear_buffer, double **output_buf)
@@ -238,6 +397,23 @@ void BoardShim::reshape_data (int num_data_points, double *linear_buffer, double
     }
 }
 
+// session might be prepared by another BoardShim object with the same params, resolve its handle
+// once, if there is no such session returns -1 and methods by handle return BOARD_NOT_CREATED_ERROR
+int BoardShim::get_handle ()
+{
+    if (session_handle < 0)
+    {
+        int handle = -1;
+        int res = ::get_session_handle (
+            &handle, board_id, const_cast<char *> (serialized_params.c_str ()));
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            session_handle = handle;
+        }
+    }
+    return session_handle;
+}
+
 int BoardShim::get_board_id ()
 {
     int master_board_id = board_id;
@@ -21,6 +21,10 @@ class BoardShim
     // method.
     std::string serialized_params;
     struct BrainFlowInputParams params;
+    // handle of the session, resolved once to avoid passing json params in each call
+    int session_handle;
+    int get_handle ();
+    template <typename Func> int call_by_handle (Func func);
 
 public:
     // clang-format off
@@ -178,7 +182,13 @@ public:
      * @param buffer_size size of internal ring buffer
      * @param streamer_params use it to pass data packages further or store them directly during streaming,
                     supported values: "file://%file_name%:w", "file://%file_name%:a", "streaming_board://%multicast_group_ip%:%port%"".
-                    Range for multicast addresses is from "224.0.0.0" to "239.255.255.255"
+                    Range for multicast addresses is from "224.0.0.0" to "239.255.255.255".
+                    Optional queue settings can be added after '?': "file://%file_name%:w?queue_size=8192&overflow=block",
+                    overflow is block, drop or count. Several destinations can be separated by ';', each of them runs in its own thread,
+                    default overflow is block for a single destination and count for several of them, blocking destination delays all other ones
+                    streaming_board accepts batch=packages per datagram(default fills 1472 bytes), flush_ms=max delay before sending
+                    incomplete batch and version=0 for old protocol with one package per datagram
+                    Files with ".bfb" extension are written in binary block format, they are smaller and faster to write and read
      */
     void start_stream (int buffer_size = 450000, char *streamer_params = NULL);
     /// check if session is ready or not
@@ -193,11 +203,54 @@ public:
     int get_board_id ();
     /// get number of packages in ringbuffer
     int get_board_data_count ();
+    /// block until ringbuffer has at least min_samples packages, returns false on timeout
+    bool wait_for_board_data (int min_samples, int timeout_ms);
     /// get all collected data and flush it from internal buffer
     double **get_board_data (int *num_data_points);
     /// send string to a board, use it carefully and only if you understand what you are doing
     std::string config_board (char *config);
     /// insert marker in data stream
     void insert_marker (double value);
+    /// insert marker to the sample with the nearest timestamp, timestamp is unix time in seconds
+    void insert_marker (double value, double timestamp);
+    /**
+     * get state of streamer queue, streamers run in their own threads and read thread only puts
+     * packages to the queue
+     * @param streamer_index index of streamer, 0 for the first one
+     * @param queue_depth number of packages waiting in queue
+     * @param max_queue_depth max number of packages in queue since start_stream
+     * @param num_dropped number of packages dropped because queue was full
+     */
+    void get_streamer_stats (
+        int streamer_index, int *queue_depth, int *max_queue_depth, int *num_dropped);
+    /// add named reader, it gets only samples which come after this call
+    void add_reader_cursor (char *cursor_name);
+    void remove_reader_cursor (char *cursor_name);
+    /// get samples which came after previous call for this cursor, doesnt remove data for others
+    double **get_board_data_since (char *cursor_name, int *num_data_points);
+    /**
+     * get state of reader cursor
+     * @param data_count number of samples which were not read by this cursor yet
+     * @param num_lost number of samples overwritten before this cursor read them
+     */
+    void get_reader_cursor_stats (char *cursor_name, int *data_count, int *num_lost);
+    /**
+     * register callback for new packages, it is called from dispatch thread with channel-major
+     * batch data[channel * num_samples + i] and must not call methods of this board
+     * @param batch_size max number of packages in one call
+     * @param max_delay_ms deliver incomplete batch after this delay, 0 to deliver only full batches
+     * @return subscription id for unsubscribe_board_data
+     */
+    int subscribe_board_data (
+        board_data_callback callback, void *user_data, int batch_size, int max_delay_ms);
+    /// remove callback, packages already queued for it are delivered before return
+    void unsubscribe_board_data (int subscription_id);
+    /**
+     * get state of subscription queue
+     * @param lag number of packages waiting for callback
+     * @param max_lag max number of packages waiting for callback since subscribe
+     * @param num_dropped number of packages dropped because callback was too slow
+     */
+    void get_subscription_stats (int subscription_id, int *lag, int *max_lag, int *num_dropped);
     // clang-format on
 };
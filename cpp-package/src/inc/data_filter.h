@@ -123,10 +123,10 @@ public:
     static std::pair<double *, double *> get_avg_band_powers (double **data, int cols,
         int *channels, int channels_len, int sampling_rate, bool apply_filters);
 
-    /// write file, in file data will be transposed
+    /// write file, in file data will be transposed, files with ".bfb" extension are binary
     static void write_file (
         double **data, int num_rows, int num_cols, char *file_name, char *file_mode);
-    /// read data from file, data will be transposed to original format
+    /// read data from file, data will be transposed to original format, binary files are detected
     static double **read_file (int *num_rows, int *num_cols, char *file_name);
 
 private:
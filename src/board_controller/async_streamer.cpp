@@ -0,0 +1,210 @@
+#include <chrono>
+#include <string.h>
+
+#include "async_streamer.h"
+#include "board.h"
+#include "brainflow_constants.h"
+
+
+AsyncStreamer::AsyncStreamer (int data_len, size_t queue_size) : Streamer (data_len)
+{
+    this->queue_size = queue_size;
+    queue = new double[queue_size * data_len];
+    write_pos = 0;
+    keep_alive = false;
+    interrupted = false;
+    producer_waiting = false;
+}
+
+AsyncStreamer::~AsyncStreamer ()
+{
+    interrupt ();
+    {
+        std::lock_guard<std::mutex> lk (m);
+        keep_alive = false;
+    }
+    cv.notify_all ();
+    // workers write all queued packages before exit
+    for (struct StreamerWorker *worker : workers)
+    {
+        if (worker->thread.joinable ())
+        {
+            worker->thread.join ();
+        }
+        delete worker->streamer;
+        delete worker;
+    }
+    workers.clear ();
+    delete[] queue;
+}
+
+void AsyncStreamer::add_streamer (Streamer *streamer, StreamerOverflowPolicy policy)
+{
+    struct StreamerWorker *worker = new struct StreamerWorker;
+    worker->streamer = streamer;
+    worker->policy = policy;
+    worker->read_pos = 0;
+    worker->num_dropped = 0;
+    worker->max_queue_depth = 0;
+    workers.push_back (worker);
+}
+
+int AsyncStreamer::init_streamer ()
+{
+    for (struct StreamerWorker *worker : workers)
+    {
+        int res = worker->streamer->init_streamer ();
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+    }
+    keep_alive = true;
+    interrupted = false;
+    for (struct StreamerWorker *worker : workers)
+    {
+        worker->thread = std::thread ([this, worker] { this->worker_thread (worker); });
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// called only from board read thread
+void AsyncStreamer::stream_data (double *data)
+{
+    uint64_t write = write_pos.load (std::memory_order_relaxed);
+    // slot for this position is the oldest one, only blocking streamers are waited for, others
+    // detect that it was overwritten and drop it
+    for (struct StreamerWorker *worker : workers)
+    {
+        if ((worker->policy.load (std::memory_order_relaxed) == StreamerOverflowPolicy::BLOCK) &&
+            (write - worker->read_pos.load (std::memory_order_acquire) >= queue_size))
+        {
+            wait_for_space (worker, write);
+        }
+    }
+    // dont let writes to the slot become visible before previous position was published, workers
+    // rely on it to detect overwritten data
+    std::atomic_thread_fence (std::memory_order_release);
+    memcpy (queue + (write % queue_size) * len, data, sizeof (double) * len);
+    write_pos.store (write + 1, std::memory_order_release);
+
+    for (struct StreamerWorker *worker : workers)
+    {
+        uint64_t depth = write + 1 - worker->read_pos.load (std::memory_order_relaxed);
+        if (depth > queue_size)
+        {
+            depth = queue_size;
+        }
+        if (depth > worker->max_queue_depth.load (std::memory_order_relaxed))
+        {
+            worker->max_queue_depth.store ((size_t)depth, std::memory_order_relaxed);
+        }
+    }
+}
+
+// called only from board read thread
+void AsyncStreamer::wait_for_space (struct StreamerWorker *worker, uint64_t write)
+{
+    worker->max_queue_depth.store (queue_size, std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lk (space_m);
+    producer_waiting = true;
+    space_cv.wait (lk, [this, worker, write] {
+        return (write - worker->read_pos.load () < queue_size) || (interrupted.load ());
+    });
+    producer_waiting = false;
+    if (write - worker->read_pos.load () >= queue_size)
+    {
+        // worker is stuck and read thread is stopping, policy is changed before the slot is
+        // overwritten so worker checks and counts overwritten packages from now on
+        worker->policy.store (StreamerOverflowPolicy::COUNT, std::memory_order_relaxed);
+        Board::board_logger->warn ("blocking streamer is stuck, its packages are dropped");
+    }
+}
+
+void AsyncStreamer::interrupt ()
+{
+    {
+        std::lock_guard<std::mutex> lk (space_m);
+        interrupted = true;
+    }
+    space_cv.notify_all ();
+}
+
+// producer doesnt notify workers to keep stream_data cheap, workers poll queue instead, delay is
+// at most WORKER_POLL_INTERVAL_MS
+void AsyncStreamer::worker_thread (struct StreamerWorker *worker)
+{
+    double *package = new double[len];
+    uint64_t dropped_in_row = 0;
+    while (true)
+    {
+        uint64_t read = worker->read_pos.load (std::memory_order_relaxed);
+        uint64_t write = write_pos.load (std::memory_order_acquire);
+        if (read == write)
+        {
+            if ((dropped_in_row > 0) && (worker->policy == StreamerOverflowPolicy::COUNT))
+            {
+                Board::board_logger->warn ("streamer queue was full, dropped {} packages, total {}",
+                    dropped_in_row, worker->num_dropped.load ());
+            }
+            dropped_in_row = 0;
+            worker->streamer->on_idle ();
+            std::unique_lock<std::mutex> lk (m);
+            if (!keep_alive)
+            {
+                break;
+            }
+            cv.wait_for (lk, std::chrono::milliseconds (WORKER_POLL_INTERVAL_MS));
+            continue;
+        }
+        for (; read < write; read++)
+        {
+            memcpy (package, queue + (read % queue_size) * len, sizeof (double) * len);
+            std::atomic_thread_fence (std::memory_order_acquire);
+            // slot for position read is reused for position read + queue_size, producer waits
+            // for blocking streamers so they never lose data
+            StreamerOverflowPolicy policy = worker->policy.load (std::memory_order_relaxed);
+            if ((policy != StreamerOverflowPolicy::BLOCK) &&
+                (write_pos.load (std::memory_order_relaxed) - read >= queue_size))
+            {
+                worker->num_dropped++;
+                dropped_in_row++;
+            }
+            else
+            {
+                worker->streamer->stream_data (package);
+            }
+            // seq_cst store and load pair with the ones in wait_for_space, producer either sees
+            // new position or is woken up
+            worker->read_pos.store (read + 1);
+            if ((policy == StreamerOverflowPolicy::BLOCK) && (producer_waiting.load ()))
+            {
+                std::lock_guard<std::mutex> lk (space_m);
+                space_cv.notify_one ();
+            }
+        }
+    }
+    delete[] package;
+}
+
+size_t AsyncStreamer::get_num_streamers ()
+{
+    return workers.size ();
+}
+
+size_t AsyncStreamer::get_queue_depth (size_t streamer_index)
+{
+    uint64_t read = workers[streamer_index]->read_pos.load (std::memory_order_acquire);
+    uint64_t depth = write_pos.load (std::memory_order_acquire) - read;
+    return (depth > queue_size) ? queue_size : (size_t)depth;
+}
+
+size_t AsyncStreamer::get_max_queue_depth (size_t streamer_index)
+{
+    return workers[streamer_index]->max_queue_depth.load (std::memory_order_relaxed);
+}
+
+uint64_t AsyncStreamer::get_num_dropped (size_t streamer_index)
+{
+    return workers[streamer_index]->num_dropped.load (std::memory_order_relaxed);
+}
@@ -0,0 +1,75 @@
+#include <string.h>
+
+#include "binary_file_streamer.h"
+#include "brainflow_constants.h"
+
+
+BinaryFileStreamer::BinaryFileStreamer (
+    const char *file, const char *file_mode, int board_id, const BoardDescriptor &descr)
+    : Streamer (descr.num_rows)
+{
+    strcpy (this->file, file);
+    strcpy (this->file_mode, file_mode);
+    this->board_id = board_id;
+    sampling_rate = descr.sampling_rate;
+
+    channel_map.resize (descr.num_rows, (int32_t)BinaryChannelType::UNKNOWN);
+    struct
+    {
+        int channel;
+        BinaryChannelType type;
+    } single_channels[] = {{descr.package_num_channel, BinaryChannelType::PACKAGE_NUM},
+        {descr.timestamp_channel, BinaryChannelType::TIMESTAMP},
+        {descr.marker_channel, BinaryChannelType::MARKER},
+        {descr.battery_channel, BinaryChannelType::BATTERY}};
+    struct
+    {
+        const ChannelList *channels;
+        BinaryChannelType type;
+    } channel_lists[] = {{&descr.eeg_channels, BinaryChannelType::EEG},
+        {&descr.emg_channels, BinaryChannelType::EMG},
+        {&descr.ecg_channels, BinaryChannelType::ECG},
+        {&descr.eog_channels, BinaryChannelType::EOG},
+        {&descr.accel_channels, BinaryChannelType::ACCEL},
+        {&descr.gyro_channels, BinaryChannelType::GYRO},
+        {&descr.analog_channels, BinaryChannelType::ANALOG},
+        {&descr.eda_channels, BinaryChannelType::EDA},
+        {&descr.ppg_channels, BinaryChannelType::PPG},
+        {&descr.temperature_channels, BinaryChannelType::TEMPERATURE},
+        {&descr.resistance_channels, BinaryChannelType::RESISTANCE},
+        {&descr.other_channels, BinaryChannelType::OTHER}};
+    // some boards share rows between types(e.g. eeg and emg), first type wins
+    for (auto &list : channel_lists)
+    {
+        for (int channel : *list.channels)
+        {
+            if ((channel >= 0) && (channel < descr.num_rows) &&
+                (channel_map[channel] == (int32_t)BinaryChannelType::UNKNOWN))
+            {
+                channel_map[channel] = (int32_t)list.type;
+            }
+        }
+    }
+    for (auto &single : single_channels)
+    {
+        if ((single.channel >= 0) && (single.channel < descr.num_rows))
+        {
+            channel_map[single.channel] = (int32_t)single.type;
+        }
+    }
+}
+
+BinaryFileStreamer::~BinaryFileStreamer ()
+{
+    writer.close_file ();
+}
+
+int BinaryFileStreamer::init_streamer ()
+{
+    return writer.open_file (file, file_mode, board_id, len, sampling_rate, channel_map.data ());
+}
+
+void BinaryFileStreamer::stream_data (double *data)
+{
+    writer.write_sample (data);
+}
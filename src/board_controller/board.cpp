@@ -1,12 +1,15 @@
+#include <algorithm>
+#include <limits.h>
+#include <map>
 #include <string>
 #include <vector>
 
+#include "binary_file_streamer.h"
 #include "board.h"
 #include "board_controller.h"
 #include "custom_cast.h"
 #include "file_streamer.h"
 #include "multicast_streamer.h"
-#include "stub_streamer.h"
 
 #include "spdlog/sinks/null_sink.h"
 
@@ -83,7 +86,7 @@ int Board::prepare_for_acquisition (int buffer_size, char *streamer_params)
     }
     if (db)
     {
-        delete db;
+        db->close ();
         db = NULL;
     }
 
@@ -100,51 +103,64 @@ int Board::prepare_for_acquisition (int buffer_size, char *streamer_params)
                 return (int)BrainFlowExitCodes::GENERAL_ERROR;
             }
         }
+        if (descr.init (board_descr) != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            safe_logger (spdlog::level::err,
+                "Invalid description in brainflow_boards.h for id {}", board_id);
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
     }
     catch (json::exception &e)
     {
         safe_logger (spdlog::level::err, e.what ());
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
+    update_descr ();
 
-    int res = prepare_streamer (streamer_params);
+    std::string buffer_params;
+    int res = prepare_streamer (streamer_params, &buffer_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
 
-    db = new DataBuffer ((int)board_descr["num_rows"], buffer_size);
+    res = create_data_buffer (buffer_params, buffer_size);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
     if (!db->is_ready ())
     {
         safe_logger (spdlog::level::err, "unable to prepare buffer with size {}", buffer_size);
-        delete db;
         db = NULL;
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
+    // new buffer may already hold samples recovered from ring file, cursors get new data only
+    uint64_t write_pos = db->get_write_pos ();
+    for (auto &cursor : reader_cursors)
+    {
+        cursor.second.pos = write_pos;
+    }
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 void Board::push_package (double *package)
 {
-    lock.lock ();
-    try
+    int marker_channel = descr.marker_channel;
+    if (marker_channel < 0)
     {
-        int marker_channel = board_descr["marker_channel"];
-        if (marker_queue.empty ())
-        {
-            package[marker_channel] = 0.0;
-        }
-        else
-        {
-            double marker = marker_queue.at (0);
-            package[marker_channel] = marker;
-            marker_queue.pop_front ();
-        }
+        safe_logger (spdlog::level::err, "Failed to get marker channel/value");
     }
-    catch (...)
+    else
     {
-        safe_logger (spdlog::level::err, "Failed to get marker channel/value");
+        package[marker_channel] = pop_marker (package);
+    }
+
+    lock.lock ();
+    for (auto &subscription : subscriptions)
+    {
+        subscription.second->push (package);
     }
     lock.unlock ();
 
@@ -158,16 +174,54 @@ void Board::push_package (double *package)
     }
 }
 
-int Board::insert_marker (double value)
+// called only from read thread, one marker per sample, markers which should go to the same sample
+// are attached to the next ones in order of their timestamps
+double Board::pop_marker (const double *package)
+{
+    struct Marker marker;
+    while ((pending_markers.size () < pending_markers.capacity ()) && (marker_queue.pop (&marker)))
+    {
+        auto it = pending_markers.begin ();
+        while ((it != pending_markers.end ()) && (it->timestamp <= marker.timestamp))
+        {
+            ++it;
+        }
+        pending_markers.insert (it, marker);
+    }
+    if (pending_markers.empty ())
+    {
+        return 0.0;
+    }
+    // this sample is the nearest one if marker is before the middle between it and the next one
+    double limit = std::numeric_limits<double>::max ();
+    if ((descr.timestamp_channel >= 0) && (descr.sampling_rate > 0))
+    {
+        limit = package[descr.timestamp_channel] + 0.5 / descr.sampling_rate;
+    }
+    if (pending_markers.front ().timestamp > limit)
+    {
+        return 0.0;
+    }
+    double value = pending_markers.front ().value;
+    pending_markers.erase (pending_markers.begin ());
+    return value;
+}
+
+int Board::insert_marker (double value, double timestamp)
 {
     if (std::fabs (value) < std::numeric_limits<double>::epsilon ())
     {
         safe_logger (spdlog::level::err, "0 is a default value for marker, you can not use it.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    lock.lock ();
-    marker_queue.push_back (value);
-    lock.unlock ();
+    struct Marker marker;
+    marker.value = value;
+    marker.timestamp = timestamp;
+    if (!marker_queue.push (marker))
+    {
+        safe_logger (spdlog::level::err, "too many markers are waiting for samples");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -175,7 +229,8 @@ void Board::free_packages ()
 {
     if (db != NULL)
     {
-        delete db;
+        // buffer may be still used by waiters in wait_for_board_data
+        db->close ();
         db = NULL;
     }
 
@@ -186,81 +241,645 @@ void Board::free_packages ()
     }
 }
 
-int Board::prepare_streamer (char *streamer_params)
+// streamer_params is a list of destinations separated by ';', all of them are fed from one queue,
+// buffer and ring_file destinations are not streamers, they configure ring buffer of the session.
+// If there are several destinations default overflow policy is count instead of block, blocking
+// streamer delays read thread and all other streamers
+int Board::prepare_streamer (char *streamer_params, std::string *buffer_params)
 {
-    int num_rows = (int)board_descr["num_rows"];
-    // to dont write smth like if (streamer) every time for all boards create dummy streamer which
-    // does nothing and return an instance of this streamer if user dont specify streamer_params
-    if (streamer_params == NULL)
+    if ((streamer_params == NULL) || (streamer_params[0] == '\0'))
     {
-        safe_logger (spdlog::level::debug, "use stub streamer");
-        streamer = new StubStreamer (num_rows);
+        safe_logger (spdlog::level::debug, "streamer is not used");
+        return (int)BrainFlowExitCodes::STATUS_OK;
     }
-    else if (streamer_params[0] == '\0')
+
+    std::string streamer_params_str (streamer_params);
+    std::vector<std::string> destinations;
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    size_t start = 0;
+    while (start < streamer_params_str.size ())
     {
-        safe_logger (spdlog::level::debug, "use stub streamer");
-        streamer = new StubStreamer (num_rows);
+        size_t end = streamer_params_str.find (";", start);
+        if (end == std::string::npos)
+        {
+            end = streamer_params_str.size ();
+        }
+        std::string destination = streamer_params_str.substr (start, end - start);
+        start = end + 1;
+        if (destination.empty ())
+        {
+            continue;
+        }
+        if ((destination.find ("ring_file://") == 0) || (destination.find ("buffer://") == 0))
+        {
+            if (!buffer_params->empty ())
+            {
+                safe_logger (spdlog::level::err, "only one buffer or ring_file is allowed");
+                return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+            *buffer_params = destination;
+            continue;
+        }
+        destinations.push_back (destination);
     }
-    else
+
+    StreamerOverflowPolicy default_policy =
+        (destinations.size () > 1) ? StreamerOverflowPolicy::COUNT : StreamerOverflowPolicy::BLOCK;
+    std::vector<Streamer *> streamers;
+    std::vector<StreamerOverflowPolicy> policies;
+    std::vector<size_t> requested_sizes;
+    size_t queue_size = 0;
+    for (size_t i = 0; (i < destinations.size ()) && (res == (int)BrainFlowExitCodes::STATUS_OK);
+         i++)
     {
-        // parse string, sscanf doesnt work
-        std::string streamer_params_str (streamer_params);
-        size_t idx1 = streamer_params_str.find ("://");
-        if (idx1 == std::string::npos)
+        Streamer *sync_streamer = NULL;
+        size_t dest_queue_size = 0; // 0 if queue_size is not provided
+        StreamerOverflowPolicy policy = default_policy;
+        res = create_streamer (destinations[i], &sync_streamer, &dest_queue_size, &policy);
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
         {
-            safe_logger (
-                spdlog::level::err, "format is streamer_type://streamer_dest:streamer_args");
-            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            if ((destinations.size () > 1) && (policy == StreamerOverflowPolicy::BLOCK))
+            {
+                safe_logger (spdlog::level::warn,
+                    "streamer {} blocks on overflow, it delays all other streamers", i);
+            }
+            streamers.push_back (sync_streamer);
+            policies.push_back (policy);
+            requested_sizes.push_back (dest_queue_size);
+            // queue is shared, use the biggest requested size
+            queue_size = std::max (queue_size, dest_queue_size);
         }
-        std::string streamer_type = streamer_params_str.substr (0, idx1);
-        size_t idx2 = streamer_params_str.find_last_of (":", std::string::npos);
-        if ((idx2 == std::string::npos) || (idx1 == idx2))
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        for (Streamer *sync_streamer : streamers)
         {
-            safe_logger (
-                spdlog::level::err, "format is streamer_type://streamer_dest:streamer_args");
+            delete sync_streamer;
+        }
+        return res;
+    }
+    if (streamers.empty ())
+    {
+        safe_logger (spdlog::level::debug, "streamer is not used");
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    if (queue_size == 0)
+    {
+        queue_size = DEFAULT_STREAMER_QUEUE_SIZE;
+    }
+    for (size_t i = 0; i < requested_sizes.size (); i++)
+    {
+        if ((requested_sizes[i] != 0) && (requested_sizes[i] != queue_size))
+        {
+            safe_logger (spdlog::level::warn,
+                "queue_size {} requested for streamer {}, shared queue has size {}",
+                requested_sizes[i], i, queue_size);
+        }
+    }
+
+    // streamers run in their own threads to dont block read thread
+    streamer = new AsyncStreamer (descr.num_rows, queue_size);
+    for (size_t i = 0; i < streamers.size (); i++)
+    {
+        streamer->add_streamer (streamers[i], policies[i]);
+    }
+    res = streamer->init_streamer ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "failed to init streamer");
+        delete streamer;
+        streamer = NULL;
+    }
+
+    return res;
+}
+
+int Board::create_streamer (std::string streamer_params, Streamer **sync_streamer,
+    size_t *queue_size, StreamerOverflowPolicy *policy)
+{
+    int num_rows = descr.num_rows;
+    // parse string, sscanf doesnt work
+    size_t idx1 = streamer_params.find ("://");
+    if (idx1 == std::string::npos)
+    {
+        safe_logger (spdlog::level::err,
+            "format is streamer_type://streamer_dest:streamer_args[?option=value&...]");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // options which are not common for all streamers are checked by streamer type
+    std::map<std::string, std::string> streamer_options;
+    size_t options_idx = streamer_params.find_last_of ("?");
+    if ((options_idx != std::string::npos) && (options_idx > idx1))
+    {
+        int res = parse_streamer_options (
+            streamer_params.substr (options_idx + 1), queue_size, policy, &streamer_options);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        streamer_params = streamer_params.substr (0, options_idx);
+    }
+    std::string streamer_type = streamer_params.substr (0, idx1);
+    size_t idx2 = streamer_params.find_last_of (":", std::string::npos);
+    if ((idx2 == std::string::npos) || (idx1 == idx2))
+    {
+        safe_logger (spdlog::level::err,
+            "format is streamer_type://streamer_dest:streamer_args[?option=value&...]");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string streamer_dest = streamer_params.substr (idx1 + 3, idx2 - idx1 - 3);
+    std::string streamer_mods = streamer_params.substr (idx2 + 1);
+
+    if (streamer_type == "file")
+    {
+        safe_logger (spdlog::level::trace, "File Streamer, file: {}, mods: {}",
+            streamer_dest.c_str (), streamer_mods.c_str ());
+        if (has_binary_extension (streamer_dest.c_str ()))
+        {
+            *sync_streamer = new BinaryFileStreamer (
+                streamer_dest.c_str (), streamer_mods.c_str (), board_id, descr);
+        }
+        else
+        {
+            SampleFormat format = SampleFormat::FLOAT64;
+            int res = pop_format_option (streamer_options, &format);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+            *sync_streamer = new FileStreamer (streamer_dest.c_str (), streamer_mods.c_str (),
+                num_rows, format, descr.timestamp_channel);
+        }
+    }
+    if (streamer_type == "streaming_board")
+    {
+        int port = 0;
+        try
+        {
+            port = std::stoi (streamer_mods);
+        }
+        catch (const std::exception &e)
+        {
+            safe_logger (spdlog::level::err, e.what ());
             return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
-        std::string streamer_dest = streamer_params_str.substr (idx1 + 3, idx2 - idx1 - 3);
-        std::string streamer_mods = streamer_params_str.substr (idx2 + 1);
+        int version = MULTICAST_FRAME_VERSION;
+        int batch_size = 0;
+        int flush_interval_ms = DEFAULT_MULTICAST_FLUSH_INTERVAL_MS;
+        int res = pop_int_option (streamer_options, "version", &version);
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = pop_int_option (streamer_options, "batch", &batch_size);
+        }
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = pop_int_option (streamer_options, "flush_ms", &flush_interval_ms);
+        }
+        SampleFormat format = SampleFormat::FLOAT64;
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = pop_format_option (streamer_options, &format);
+        }
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        *sync_streamer = new MultiCastStreamer (streamer_dest.c_str (), port, board_id, num_rows,
+            version, batch_size, flush_interval_ms, format, descr.timestamp_channel);
+    }
+
+    if (*sync_streamer == NULL)
+    {
+        safe_logger (spdlog::level::err, "unsupported streamer type {}", streamer_type.c_str ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (!streamer_options.empty ())
+    {
+        safe_logger (spdlog::level::err, "invalid option {} for streamer type {}",
+            streamer_options.begin ()->first.c_str (), streamer_type.c_str ());
+        delete *sync_streamer;
+        *sync_streamer = NULL;
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// params are empty for default buffer in memory, buffer://memory[?format=float32] or
+// ring_file://file_name:mode[?huge_pages=1&format=float32], mode is w or a, a continues existing
+// file of the same board after crash and keeps its buffer size and format
+int Board::create_data_buffer (std::string params, int buffer_size)
+{
+    if (params.empty ())
+    {
+        db = std::make_shared<DataBuffer> (descr.num_rows, buffer_size);
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    std::map<std::string, std::string> options;
+    size_t options_idx = params.find_last_of ("?");
+    if (options_idx != std::string::npos)
+    {
+        size_t queue_size = 0;
+        StreamerOverflowPolicy policy = StreamerOverflowPolicy::BLOCK;
+        int res = parse_streamer_options (
+            params.substr (options_idx + 1), &queue_size, &policy, &options);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        params = params.substr (0, options_idx);
+    }
+    SampleFormat format = SampleFormat::FLOAT64;
+    int res = pop_format_option (options, &format);
+    int huge_pages = 0;
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = pop_int_option (options, "huge_pages", &huge_pages);
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if (!options.empty ())
+    {
+        safe_logger (spdlog::level::err, "invalid option {} for {}",
+            options.begin ()->first.c_str (), params.c_str ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (params == "buffer://memory")
+    {
+        db = std::make_shared<DataBuffer> (
+            descr.num_rows, buffer_size, format, descr.timestamp_channel);
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    size_t idx1 = params.find ("://");
+    size_t idx2 = params.find_last_of (":");
+    if ((params.find ("ring_file://") != 0) || (idx1 == idx2))
+    {
+        safe_logger (spdlog::level::err,
+            "format is buffer://memory[?options] or ring_file://file_name:mode[?options]");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string file_name = params.substr (idx1 + 3, idx2 - idx1 - 3);
+    std::string mode = params.substr (idx2 + 1);
+    if ((mode != "w") && (mode != "a"))
+    {
+        safe_logger (spdlog::level::err, "mode for ring_file should be w or a");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    RingFile *ring_file = new RingFile ();
+    res = ring_file->open_file (file_name.c_str (), mode.c_str (), board_id, descr.num_rows,
+        (size_t)buffer_size, huge_pages != 0, format, descr.timestamp_channel);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "failed to open ring file {}", file_name.c_str ());
+        delete ring_file;
+        return res;
+    }
+    struct RingFileHeader *header = ring_file->get_header ();
+    if ((header->buffer_size != (uint64_t)buffer_size) ||
+        (header->sample_format != (int32_t)format))
+    {
+        safe_logger (spdlog::level::warn, "ring file {} keeps its buffer size {} and format {}",
+            file_name.c_str (), header->buffer_size, header->sample_format);
+    }
+    if ((huge_pages != 0) && (!ring_file->is_huge_pages ()))
+    {
+        safe_logger (spdlog::level::warn,
+            "{} is not in hugetlbfs, huge pages are requested but may be not used",
+            file_name.c_str ());
+    }
+    safe_logger (spdlog::level::info, "ring buffer is stored in {}, {} samples recovered",
+        file_name.c_str (), ring_file->get_num_samples ());
+    db = std::make_shared<DataBuffer> (ring_file);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// removes format option from map, its ok if option is not provided
+int Board::pop_format_option (
+    std::map<std::string, std::string> &streamer_options, SampleFormat *format)
+{
+    auto it = streamer_options.find ("format");
+    if (it == streamer_options.end ())
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    if (!parse_sample_format (it->second, format))
+    {
+        safe_logger (spdlog::level::err, "invalid format {}, use float64 or float32",
+            it->second.c_str ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    streamer_options.erase (it);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// removes option from map, its ok if option is not provided
+int Board::pop_int_option (
+    std::map<std::string, std::string> &streamer_options, const char *key, int *value)
+{
+    auto it = streamer_options.find (key);
+    if (it == streamer_options.end ())
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    try
+    {
+        *value = std::stoi (it->second);
+    }
+    catch (const std::exception &e)
+    {
+        safe_logger (spdlog::level::err, "invalid value for {}: {}", key, e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    streamer_options.erase (it);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// board options in other_info are separated by '&' too, parts without '=' are skipped to keep
+// free form other_info working, board checks only its own keys
+void Board::parse_board_options (
+    std::string options, std::map<std::string, std::string> *board_options)
+{
+    size_t start = 0;
+    while (start < options.size ())
+    {
+        size_t end = options.find ("&", start);
+        if (end == std::string::npos)
+        {
+            end = options.size ();
+        }
+        std::string option = options.substr (start, end - start);
+        start = end + 1;
+        size_t eq_idx = option.find ("=");
+        if (eq_idx == std::string::npos)
+        {
+            continue;
+        }
+        (*board_options)[option.substr (0, eq_idx)] = option.substr (eq_idx + 1);
+    }
+}
 
-        if (streamer_type == "file")
+// options are separated by '&': queue_size=number of packages, overflow=block|drop|count, other
+// options are returned in streamer_options and checked by create_streamer
+int Board::parse_streamer_options (std::string options, size_t *queue_size,
+    StreamerOverflowPolicy *policy, std::map<std::string, std::string> *streamer_options)
+{
+    size_t start = 0;
+    while (start < options.size ())
+    {
+        size_t end = options.find ("&", start);
+        if (end == std::string::npos)
         {
-            safe_logger (spdlog::level::trace, "File Streamer, file: {}, mods: {}",
-                streamer_dest.c_str (), streamer_mods.c_str ());
-            streamer = new FileStreamer (streamer_dest.c_str (), streamer_mods.c_str (), num_rows);
+            end = options.size ();
         }
-        if (streamer_type == "streaming_board")
+        std::string option = options.substr (start, end - start);
+        start = end + 1;
+        size_t eq_idx = option.find ("=");
+        if (eq_idx == std::string::npos)
         {
-            int port = 0;
+            safe_logger (spdlog::level::err, "invalid streamer option {}", option.c_str ());
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        std::string key = option.substr (0, eq_idx);
+        std::string value = option.substr (eq_idx + 1);
+        if (key == "queue_size")
+        {
+            int size = 0;
             try
             {
-                port = std::stoi (streamer_mods);
+                size = std::stoi (value);
             }
             catch (const std::exception &e)
             {
                 safe_logger (spdlog::level::err, e.what ());
                 return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
             }
-            streamer = new MultiCastStreamer (streamer_dest.c_str (), port, num_rows);
+            if (size <= 0)
+            {
+                safe_logger (spdlog::level::err, "queue_size should be positive");
+                return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+            *queue_size = (size_t)size;
         }
-
-        if (streamer == NULL)
+        else if ((key == "overflow") && (value == "block"))
+        {
+            *policy = StreamerOverflowPolicy::BLOCK;
+        }
+        else if ((key == "overflow") && (value == "drop"))
+        {
+            *policy = StreamerOverflowPolicy::DROP;
+        }
+        else if ((key == "overflow") && (value == "count"))
         {
-            safe_logger (
-                spdlog::level::err, "unsupported streamer type {}", streamer_type.c_str ());
+            *policy = StreamerOverflowPolicy::COUNT;
+        }
+        else if (key == "overflow")
+        {
+            safe_logger (spdlog::level::err, "invalid streamer option {}", option.c_str ());
             return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
+        else
+        {
+            (*streamer_options)[key] = value;
+        }
     }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    int res = streamer->init_streamer ();
-    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+int Board::get_streamer_stats (
+    int streamer_index, int *queue_depth, int *max_queue_depth, int *num_dropped)
+{
+    if ((queue_depth == NULL) || (max_queue_depth == NULL) || (num_dropped == NULL))
     {
-        safe_logger (spdlog::level::err, "failed to init streamer");
-        delete streamer;
-        streamer = NULL;
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((streamer == NULL) || (streamer_index < 0) ||
+        ((size_t)streamer_index >= streamer->get_num_streamers ()))
+    {
+        safe_logger (spdlog::level::err, "no streamer with index {}", streamer_index);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    *queue_depth = (int)streamer->get_queue_depth (streamer_index);
+    *max_queue_depth = (int)streamer->get_max_queue_depth (streamer_index);
+    uint64_t dropped = streamer->get_num_dropped (streamer_index);
+    *num_dropped = (dropped > INT_MAX) ? INT_MAX : (int)dropped;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    return res;
+void Board::interrupt_streamer ()
+{
+    if (streamer != NULL)
+    {
+        streamer->interrupt ();
+    }
+}
+
+int Board::add_reader_cursor (std::string name)
+{
+    if (reader_cursors.find (name) != reader_cursors.end ())
+    {
+        safe_logger (spdlog::level::err, "reader cursor {} already exists", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    struct ReaderCursor cursor;
+    cursor.pos = (db != NULL) ? db->get_write_pos () : 0;
+    cursor.num_lost = 0;
+    reader_cursors[name] = cursor;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::remove_reader_cursor (std::string name)
+{
+    if (reader_cursors.erase (name) == 0)
+    {
+        safe_logger (spdlog::level::err, "no reader cursor {}", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_board_data_since (
+    std::string name, int max_samples, double *data_buf, int *returned_samples)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((data_buf == NULL) || (returned_samples == NULL) || (max_samples < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    auto it = reader_cursors.find (name);
+    if (it == reader_cursors.end ())
+    {
+        safe_logger (spdlog::level::err, "no reader cursor {}", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *returned_samples = (int)db->read_since (
+        &it->second.pos, (size_t)max_samples, data_buf, &it->second.num_lost);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_reader_cursor_stats (std::string name, int *data_count, int *num_lost)
+{
+    if ((data_count == NULL) || (num_lost == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    auto it = reader_cursors.find (name);
+    if (it == reader_cursors.end ())
+    {
+        safe_logger (spdlog::level::err, "no reader cursor {}", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // samples which are already overwritten but not yet skipped by reading are lost too
+    uint64_t pending_lost = 0;
+    *data_count = 0;
+    if (db != NULL)
+    {
+        *data_count = (int)db->get_data_count_since (it->second.pos, &pending_lost);
+    }
+    uint64_t lost = it->second.num_lost + pending_lost;
+    *num_lost = (lost > INT_MAX) ? INT_MAX : (int)lost;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::subscribe (board_data_callback callback, void *user_data, int batch_size,
+    int max_delay_ms, int *subscription_id)
+{
+    if ((callback == NULL) || (subscription_id == NULL) || (batch_size < 1) || (max_delay_ms < 0))
+    {
+        safe_logger (spdlog::level::err,
+            "invalid subscription params, batch_size {}, max_delay_ms {}", batch_size,
+            max_delay_ms);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // session may be not streaming yet, so descr may be not initialized
+    int num_rows = 0;
+    try
+    {
+        num_rows = brainflow_boards_json["boards"][int_to_string (board_id)]["num_rows"];
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, e.what ());
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    if (num_rows < 1)
+    {
+        safe_logger (spdlog::level::err, "invalid num_rows for board {}", board_id);
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    DataSubscription *subscription =
+        new DataSubscription (num_rows, callback, user_data, batch_size, max_delay_ms);
+    subscription->start ();
+    lock.lock ();
+    *subscription_id = next_subscription_id++;
+    subscriptions[*subscription_id] = subscription;
+    lock.unlock ();
+    safe_logger (spdlog::level::info,
+        "subscription {} created, batch_size {}, max_delay_ms {}", *subscription_id, batch_size,
+        max_delay_ms);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::unsubscribe (int subscription_id)
+{
+    DataSubscription *subscription = NULL;
+    lock.lock ();
+    auto it = subscriptions.find (subscription_id);
+    if (it != subscriptions.end ())
+    {
+        subscription = it->second;
+        subscriptions.erase (it);
+    }
+    lock.unlock ();
+    if (subscription == NULL)
+    {
+        safe_logger (spdlog::level::err, "no subscription with id {}", subscription_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // delivers queued packages and joins dispatch thread outside spinlock
+    delete subscription;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_subscription_stats (int subscription_id, int *lag, int *max_lag, int *num_dropped)
+{
+    if ((lag == NULL) || (max_lag == NULL) || (num_dropped == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // unsubscribe is serialized with this call by session lock, spinlock is needed for lookup only
+    lock.lock ();
+    auto it = subscriptions.find (subscription_id);
+    DataSubscription *subscription = (it == subscriptions.end ()) ? NULL : it->second;
+    lock.unlock ();
+    if (subscription == NULL)
+    {
+        safe_logger (spdlog::level::err, "no subscription with id {}", subscription_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *lag = (int)subscription->get_lag ();
+    *max_lag = (int)subscription->get_max_lag ();
+    uint64_t dropped = subscription->get_num_dropped ();
+    *num_dropped = (dropped > INT_MAX) ? INT_MAX : (int)dropped;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void Board::free_subscriptions ()
+{
+    lock.lock ();
+    std::map<int, DataSubscription *> removed;
+    removed.swap (subscriptions);
+    lock.unlock ();
+    for (auto &subscription : removed)
+    {
+        delete subscription.second;
+    }
 }
 
 int Board::get_current_board_data (int num_samples, double *data_buf, int *returned_samples)
@@ -273,13 +892,8 @@ int Board::get_current_board_data (int num_samples, double *data_buf, int *retur
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    int num_rows = (int)board_descr["num_rows"];
-
-    double *buf = new double[num_samples * num_rows];
-    int num_data_points = (int)db->get_current_data (num_samples, buf);
-    reshape_data (num_data_points, buf, data_buf);
-    delete[] buf;
-    *returned_samples = num_data_points;
+    // DataBuffer stores data channel by channel, no need to reshape it
+    *returned_samples = (int)db->get_current_data (num_samples, data_buf);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -304,27 +918,17 @@ int Board::get_board_data (int data_count, double *data_buf)
     {
         return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
     }
-    if (!data_buf)
+    if ((!data_buf) || (data_count < 0))
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    int num_rows = (int)board_descr["num_rows"];
-    double *buf = new double[data_count * num_rows];
-    int num_data_points = (int)db->get_data (data_count, buf);
-    reshape_data (num_data_points, buf, data_buf);
-    delete[] buf;
-    return (int)BrainFlowExitCodes::STATUS_OK;
-}
-
-void Board::reshape_data (int data_count, const double *buf, double *output_buf)
-{
-    int num_rows = (int)board_descr["num_rows"];
-
-    for (int i = 0; i < data_count; i++)
+    // rows keep stride data_count, missing samples are zero
+    size_t filled = db->get_data (data_count, data_buf);
+    if (filled < (size_t)data_count)
     {
-        for (int j = 0; j < num_rows; j++)
-        {
-            output_buf[j * data_count + i] = buf[i * num_rows + j];
-        }
+        safe_logger (spdlog::level::warn,
+            "requested {} samples, only {} were available, the rest is filled with zeros",
+            data_count, filled);
     }
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -12,6 +12,7 @@
 #include <string.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "board.h"
 #include "board_controller.h"
@@ -40,25 +41,62 @@
 #include "unicorn_board.h"
 
 #include "json.hpp"
+#include "shared_mutex.h"
 
 using json = nlohmann::json;
 
 
-std::map<std::pair<int, struct BrainFlowInputParams>, std::shared_ptr<Board>> boards;
-std::mutex mutex;
+// session handle is (generation << SESSION_SLOT_BITS) | slot, generation is changed each time
+// slot is released so stale handles dont point to new sessions
+#define SESSION_SLOT_BITS 16
+#define MAX_SESSIONS (1 << SESSION_SLOT_BITS)
+#define MAX_SESSION_GENERATION 0x7FFF
+
+// lock serializes calls for a single board, board is NULL if session is released or failed to
+// prepare. Markers are inserted without lock, so board is changed only by atomic_store and read
+// by atomic_load if lock is not held, reference taken by marker insert keeps board alive
+struct BoardSession
+{
+    std::shared_ptr<Board> board;
+    std::mutex lock;
+};
+
+struct SessionSlot
+{
+    std::shared_ptr<struct BoardSession> session;
+    std::pair<int, struct BrainFlowInputParams> key;
+    int generation;
+};
+
+// slots are accessed by handle in O(1), map is used only to resolve board_id and params
+// registry_lock guards both of them, it's locked exclusively only to add or remove session and to
+// create board objects(some of them count instances in static fields), all other methods lock it
+// in shared mode only to find a session and after that use BoardSession::lock.
+// BoardSession::lock can be held while locking registry_lock but not vice versa. Boards are
+// destroyed after registry_lock is released, destructor joins subscription threads and their
+// callbacks may call methods of other sessions
+std::vector<struct SessionSlot> sessions;
+std::map<std::pair<int, struct BrainFlowInputParams>, int> handles;
+SharedMutex registry_lock;
+std::mutex log_lock;
 
 std::pair<int, struct BrainFlowInputParams> get_key (
     int board_id, struct BrainFlowInputParams params);
-static int check_board_session (int board_id, char *json_brainflow_input_params,
-    std::pair<int, struct BrainFlowInputParams> &key, bool log_error = true);
+static std::shared_ptr<struct BoardSession> get_session (int session_handle);
+static std::shared_ptr<struct BoardSession> find_session (int session_handle);
+static void remove_session (int session_handle);
+static int find_session_handle (
+    int board_id, char *json_brainflow_input_params, int *session_handle);
 static int string_to_brainflow_input_params (
     const char *json_brainflow_input_params, struct BrainFlowInputParams *params);
 
 
-int prepare_session (int board_id, char *json_brainflow_input_params)
+int prepare_session_handle (int *session_handle, int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
+    if (session_handle == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
     Board::board_logger->info ("incoming json: {}", json_brainflow_input_params);
     struct BrainFlowInputParams params;
     int res = string_to_brainflow_input_params (json_brainflow_input_params, &params);
@@ -68,13 +106,25 @@ int prepare_session (int board_id, char *json_brainflow_input_params)
     }
 
     std::pair<int, struct BrainFlowInputParams> key = get_key (board_id, params);
-    if (boards.find (key) != boards.end ())
+    std::unique_lock<SharedMutex> registry (registry_lock);
+    if (handles.find (key) != handles.end ())
     {
         Board::board_logger->error (
             "Board with id {} and the same config already exists", board_id);
         return (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR;
     }
 
+    size_t slot = 0;
+    while ((slot < sessions.size ()) && (sessions[slot].session != NULL))
+    {
+        slot++;
+    }
+    if (slot >= MAX_SESSIONS)
+    {
+        Board::board_logger->error ("Too many sessions, max is {}", MAX_SESSIONS);
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+
     std::shared_ptr<Board> board = NULL;
     switch (static_cast<BoardIds> (board_id))
     {
@@ -146,24 +196,425 @@ int prepare_session (int board_id, char *json_brainflow_input_params)
             return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
     }
     Board::board_logger->trace ("Board object created {}", board->get_board_id ());
-    res = board->prepare_session ();
+
+    // register session before preparing it to reject the same config from other threads, calls
+    // for this session wait for session lock until prepare_session is done. It's safe to lock
+    // session here because no other thread can see it yet
+    if (slot == sessions.size ())
+    {
+        struct SessionSlot new_slot;
+        new_slot.generation = 0;
+        sessions.push_back (new_slot);
+    }
+    std::shared_ptr<struct BoardSession> session (new BoardSession ());
+    session->board = board;
+    std::unique_lock<std::mutex> session_lock (session->lock);
+    int handle = (sessions[slot].generation << SESSION_SLOT_BITS) | (int)slot;
+    sessions[slot].session = session;
+    sessions[slot].key = key;
+    handles[key] = handle;
+    registry.unlock ();
+    board = NULL;
+
+    res = session->board->prepare_session ();
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
+        registry.lock ();
+        remove_session (handle);
+        board = std::atomic_exchange (&session->board, std::shared_ptr<Board> ());
+        registry.unlock ();
         board = NULL;
     }
     else
     {
-        boards[key] = board;
+        *session_handle = handle;
     }
     return res;
 }
 
-int is_prepared (int *prepared, int board_id, char *json_brainflow_input_params)
+int get_session_handle (int *session_handle, int board_id, char *json_brainflow_input_params)
+{
+    if (session_handle == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return find_session_handle (board_id, json_brainflow_input_params, session_handle);
+}
+
+int is_prepared_by_handle (int *prepared, int session_handle)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    *prepared = 0;
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session != NULL)
+    {
+        std::lock_guard<std::mutex> lock (session->lock);
+        *prepared = (session->board != NULL) ? 1 : 0;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int start_stream_by_handle (int buffer_size, char *streamer_params, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->start_stream (buffer_size, streamer_params);
+}
+
+int stop_stream_by_handle (int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    // stuck streamer doesnt block read thread which is joined by stop_stream
+    session->board->interrupt_streamer ();
+    return session->board->stop_stream ();
+}
+
+int insert_marker_by_handle (double value, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    // marker queue is lock free, session lock is not taken to dont wait for other calls
+    std::shared_ptr<Board> board = std::atomic_load (&session->board);
+    if (board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return board->insert_marker (value);
+}
+
+int insert_marker_with_timestamp_by_handle (double value, double timestamp, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    // marker queue is lock free, session lock is not taken to dont wait for other calls
+    std::shared_ptr<Board> board = std::atomic_load (&session->board);
+    if (board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return board->insert_marker (value, timestamp);
+}
+
+int release_session_by_handle (int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    session->board->interrupt_streamer ();
+    int res = session->board->release_session ();
+    // other threads may still hold this session, they will see that board is NULL
+    std::shared_ptr<Board> board;
+    {
+        std::lock_guard<SharedMutex> registry (registry_lock);
+        remove_session (session_handle);
+        board = std::atomic_exchange (&session->board, std::shared_ptr<Board> ());
+    }
+    // destroy board without registry_lock
+    board = NULL;
+    return res;
+}
+
+int get_current_board_data_by_handle (
+    int num_samples, double *data_buf, int *returned_samples, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_current_board_data (num_samples, data_buf, returned_samples);
+}
+
+int get_board_data_count_by_handle (int *result, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_board_data_count (result);
+}
+
+int get_board_data_by_handle (int data_count, double *data_buf, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_board_data (data_count, data_buf);
+}
+
+int config_board_by_handle (char *config, char *response, int *response_len, int session_handle)
+{
+    if ((config == NULL) || (response == NULL) || (response_len == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::string conf = config;
+    std::string resp = "";
+    int res = session->board->config_board (conf, resp);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        *response_len = (int)resp.length ();
+        strcpy (response, resp.c_str ());
+    }
+    return res;
+}
+
+int get_streamer_stats_by_handle (int streamer_index, int *queue_depth, int *max_queue_depth,
+    int *num_dropped, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_streamer_stats (
+        streamer_index, queue_depth, max_queue_depth, num_dropped);
+}
+
+int wait_for_board_data_by_handle (int min_samples, int timeout_ms, int session_handle)
+{
+    if ((min_samples <= 0) || (timeout_ms < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::shared_ptr<DataBuffer> buffer;
+    {
+        std::lock_guard<std::mutex> lock (session->lock);
+        if (session->board == NULL)
+        {
+            return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+        }
+        buffer = session->board->get_data_buffer ();
+    }
+    if (buffer == NULL)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((size_t)min_samples > buffer->get_max_count ())
+    {
+        Board::board_logger->error ("min_samples {} is bigger than buffer size {}", min_samples,
+            buffer->get_max_count ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // session lock is not held here, other methods for this board are not blocked by waiter
+    if (buffer->wait_for_data ((size_t)min_samples, timeout_ms) < (size_t)min_samples)
+    {
+        return (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int add_reader_cursor_by_handle (char *cursor_name, int session_handle)
+{
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->add_reader_cursor (cursor_name);
+}
+
+int remove_reader_cursor_by_handle (char *cursor_name, int session_handle)
+{
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->remove_reader_cursor (cursor_name);
+}
+
+int get_board_data_since_by_handle (char *cursor_name, int max_samples, double *data_buf,
+    int *returned_samples, int session_handle)
+{
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_board_data_since (
+        cursor_name, max_samples, data_buf, returned_samples);
+}
+
+int get_reader_cursor_stats_by_handle (
+    char *cursor_name, int *data_count, int *num_lost, int session_handle)
+{
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_reader_cursor_stats (cursor_name, data_count, num_lost);
+}
+
+int subscribe_board_data_by_handle (board_data_callback callback, void *user_data, int batch_size,
+    int max_delay_ms, int *subscription_id, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->subscribe (
+        callback, user_data, batch_size, max_delay_ms, subscription_id);
+}
+
+int unsubscribe_board_data_by_handle (int subscription_id, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->unsubscribe (subscription_id);
+}
+
+int get_subscription_stats_by_handle (
+    int subscription_id, int *lag, int *max_lag, int *num_dropped, int session_handle)
+{
+    std::shared_ptr<struct BoardSession> session = get_session (session_handle);
+    if (session == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (session->lock);
+    if (session->board == NULL)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_subscription_stats (subscription_id, lag, max_lag, num_dropped);
+}
+
+/////////////////////////////////////////////////
+///// methods with board_id and json params /////
+/////////////////////////////////////////////////
+
+// resolve session handle once and call method above, dont hold the lock between these calls
+
+int prepare_session (int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    return prepare_session_handle (&session_handle, board_id, json_brainflow_input_params);
+}
+
+int is_prepared (int *prepared, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         *prepared = 1;
@@ -179,109 +630,226 @@ int is_prepared (int *prepared, int board_id, char *json_brainflow_input_params)
 int start_stream (
     int buffer_size, char *streamer_params, int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->start_stream (buffer_size, streamer_params);
+    return start_stream_by_handle (buffer_size, streamer_params, session_handle);
 }
 
 int stop_stream (int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->stop_stream ();
+    return stop_stream_by_handle (session_handle);
 }
 
 int insert_marker (double value, int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return insert_marker_by_handle (value, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int insert_marker_with_timestamp (
+    double value, double timestamp, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->insert_marker (value);
+    return insert_marker_with_timestamp_by_handle (value, timestamp, session_handle);
 }
 
 int release_session (int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    res = board_it->second->release_session ();
-    boards.erase (board_it);
-    return res;
+    return release_session_by_handle (session_handle);
 }
 
 int get_current_board_data (int num_samples, double *data_buf, int *returned_samples, int board_id,
     char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_current_board_data (num_samples, data_buf, returned_samples);
+    return get_current_board_data_by_handle (
+        num_samples, data_buf, returned_samples, session_handle);
 }
 
 int get_board_data_count (int *result, int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_board_data_count (result);
+    return get_board_data_count_by_handle (result, session_handle);
 }
 
 int get_board_data (
     int data_count, double *data_buf, int board_id, char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_board_data_by_handle (data_count, data_buf, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int config_board (char *config, char *response, int *response_len, int board_id,
+    char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return config_board_by_handle (config, response, response_len, session_handle);
+}
+
+int get_streamer_stats (int streamer_index, int *queue_depth, int *max_queue_depth,
+    int *num_dropped, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_streamer_stats_by_handle (
+        streamer_index, queue_depth, max_queue_depth, num_dropped, session_handle);
+}
+
+int wait_for_board_data (
+    int min_samples, int timeout_ms, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return wait_for_board_data_by_handle (min_samples, timeout_ms, session_handle);
+}
+
+int add_reader_cursor (char *cursor_name, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return add_reader_cursor_by_handle (cursor_name, session_handle);
+}
+
+int remove_reader_cursor (
+    char *cursor_name, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return remove_reader_cursor_by_handle (cursor_name, session_handle);
+}
+
+int get_board_data_since (char *cursor_name, int max_samples, double *data_buf,
+    int *returned_samples, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_board_data_since_by_handle (
+        cursor_name, max_samples, data_buf, returned_samples, session_handle);
+}
+
+int get_reader_cursor_stats (char *cursor_name, int *data_count, int *num_lost, int board_id,
+    char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_reader_cursor_stats_by_handle (cursor_name, data_count, num_lost, session_handle);
+}
+
+int subscribe_board_data (board_data_callback callback, void *user_data, int batch_size,
+    int max_delay_ms, int *subscription_id, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return subscribe_board_data_by_handle (
+        callback, user_data, batch_size, max_delay_ms, subscription_id, session_handle);
+}
+
+int unsubscribe_board_data (
+    int subscription_id, int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return unsubscribe_board_data_by_handle (subscription_id, session_handle);
+}
+
+int get_subscription_stats (int subscription_id, int *lag, int *max_lag, int *num_dropped,
+    int board_id, char *json_brainflow_input_params)
+{
+    int session_handle = -1;
+    int res = get_session_handle (&session_handle, board_id, json_brainflow_input_params);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_board_data (data_count, data_buf);
+    return get_subscription_stats_by_handle (
+        subscription_id, lag, max_lag, num_dropped, session_handle);
 }
 
+/////////////////////////////////////////////////
+/////////////////// logging /////////////////////
+/////////////////////////////////////////////////
+
 int set_log_level (int log_level)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    std::lock_guard<std::mutex> lock (log_lock);
     return Board::set_log_level (log_level);
 }
 
@@ -289,7 +857,7 @@ int log_message (int log_level, char *log_message)
 {
     // its a method for loggging from high level api dont add it to Board class since it should not
     // be used internally
-    std::lock_guard<std::mutex> lock (mutex);
+    std::lock_guard<std::mutex> lock (log_lock);
     if (log_level < 0)
     {
         Board::board_logger->warn ("log level should be >= 0");
@@ -308,37 +876,10 @@ int log_message (int log_level, char *log_message)
 
 int set_log_file (char *log_file)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    std::lock_guard<std::mutex> lock (log_lock);
     return Board::set_log_file (log_file);
 }
 
-int config_board (char *config, char *response, int *response_len, int board_id,
-    char *json_brainflow_input_params)
-{
-    std::lock_guard<std::mutex> lock (mutex);
-    if ((config == NULL) || (response == NULL) || (response_len == NULL))
-    {
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-    }
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
-    if (res != (int)BrainFlowExitCodes::STATUS_OK)
-    {
-        return res;
-    }
-    auto board_it = boards.find (key);
-    std::string conf = config;
-    std::string resp = "";
-    res = board_it->second->config_board (conf, resp);
-    if (res == (int)BrainFlowExitCodes::STATUS_OK)
-    {
-        *response_len = (int)resp.length ();
-        strcpy (response, resp.c_str ());
-    }
-    return res;
-}
-
 /////////////////////////////////////////////////
 //////////////////// helpers ////////////////////
 /////////////////////////////////////////////////
@@ -350,8 +891,38 @@ std::pair<int, struct BrainFlowInputParams> get_key (
     return key;
 }
 
-int check_board_session (int board_id, char *json_brainflow_input_params,
-    std::pair<int, struct BrainFlowInputParams> &key, bool log_error)
+std::shared_ptr<struct BoardSession> get_session (int session_handle)
+{
+    SharedLock registry (registry_lock);
+    return find_session (session_handle);
+}
+
+// registry_lock should be held by caller
+std::shared_ptr<struct BoardSession> find_session (int session_handle)
+{
+    if (session_handle < 0)
+    {
+        return NULL;
+    }
+    size_t slot = (size_t)(session_handle & (MAX_SESSIONS - 1));
+    int generation = session_handle >> SESSION_SLOT_BITS;
+    if ((slot >= sessions.size ()) || (sessions[slot].generation != generation))
+    {
+        return NULL;
+    }
+    return sessions[slot].session;
+}
+
+// registry_lock should be held by caller in exclusive mode
+void remove_session (int session_handle)
+{
+    struct SessionSlot &slot = sessions[session_handle & (MAX_SESSIONS - 1)];
+    handles.erase (slot.key);
+    slot.session = NULL;
+    slot.generation = (slot.generation + 1) & MAX_SESSION_GENERATION;
+}
+
+int find_session_handle (int board_id, char *json_brainflow_input_params, int *session_handle)
 {
     struct BrainFlowInputParams params;
     int res = string_to_brainflow_input_params (json_brainflow_input_params, &params);
@@ -360,17 +931,14 @@ int check_board_session (int board_id, char *json_brainflow_input_params,
         return res;
     }
 
-    key = get_key (board_id, params);
-
-    if (boards.find (key) == boards.end ())
+    std::pair<int, struct BrainFlowInputParams> key = get_key (board_id, params);
+    SharedLock registry (registry_lock);
+    auto handle_it = handles.find (key);
+    if (handle_it == handles.end ())
     {
-        if (log_error)
-        {
-            Board::board_logger->error (
-                "Board with id {} and port provided config is not created", key.first);
-        }
         return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
     }
+    *session_handle = handle_it->second;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
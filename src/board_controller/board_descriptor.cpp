@@ -0,0 +1,85 @@
+#include "board_descriptor.h"
+#include "brainflow_constants.h"
+
+
+static int get_single_value (const json &board_descr, const char *field, int *value)
+{
+    auto it = board_descr.find (field);
+    if (it == board_descr.end ())
+    {
+        *value = -1;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    if (!it->is_number_integer ())
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    *value = it->get<int> ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int get_array_value (const json &board_descr, const char *field, ChannelList *channels)
+{
+    channels->len = 0;
+    auto it = board_descr.find (field);
+    if (it == board_descr.end ())
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    if ((!it->is_array ()) || (it->size () > MAX_CHANNELS_PER_TYPE))
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    for (const json &channel : *it)
+    {
+        if (!channel.is_number_integer ())
+        {
+            channels->len = 0;
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+        channels->channels[channels->len++] = channel.get<int> ();
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BoardDescriptor::init (const json &board_descr)
+{
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    struct
+    {
+        const char *name;
+        int *value;
+    } single_values[] = {{"num_rows", &num_rows}, {"sampling_rate", &sampling_rate},
+        {"package_num_channel", &package_num_channel}, {"timestamp_channel", &timestamp_channel},
+        {"marker_channel", &marker_channel}, {"battery_channel", &battery_channel}};
+    struct
+    {
+        const char *name;
+        ChannelList *value;
+    } array_values[] = {{"eeg_channels", &eeg_channels}, {"emg_channels", &emg_channels},
+        {"ecg_channels", &ecg_channels}, {"eog_channels", &eog_channels},
+        {"accel_channels", &accel_channels}, {"gyro_channels", &gyro_channels},
+        {"analog_channels", &analog_channels}, {"eda_channels", &eda_channels},
+        {"ppg_channels", &ppg_channels}, {"temperature_channels", &temperature_channels},
+        {"resistance_channels", &resistance_channels}, {"other_channels", &other_channels}};
+
+    for (auto &field : single_values)
+    {
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = get_single_value (board_descr, field.name, field.value);
+        }
+    }
+    for (auto &field : array_values)
+    {
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = get_array_value (board_descr, field.name, field.value);
+        }
+    }
+    if ((res == (int)BrainFlowExitCodes::STATUS_OK) && (num_rows <= 0))
+    {
+        res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return res;
+}
@@ -0,0 +1,169 @@
+#include <string.h>
+#include <vector>
+
+#include "data_subscription.h"
+
+
+DataSubscription::DataSubscription (int num_rows, board_data_callback callback, void *user_data,
+    int batch_size, int max_delay_ms)
+{
+    this->num_rows = num_rows;
+    this->callback = callback;
+    this->user_data = user_data;
+    this->batch_size = batch_size;
+    this->max_delay_ms = max_delay_ms;
+    queue_size = DEFAULT_SUBSCRIPTION_QUEUE_SIZE;
+    if (queue_size < 2 * (size_t)batch_size)
+    {
+        queue_size = 2 * (size_t)batch_size;
+    }
+    queue = new double[queue_size * num_rows];
+    write_pos = 0;
+    read_pos = 0;
+    max_lag = 0;
+    num_dropped = 0;
+    keep_alive = false;
+    is_waiting = false;
+}
+
+DataSubscription::~DataSubscription ()
+{
+    {
+        std::lock_guard<std::mutex> lk (m);
+        keep_alive = false;
+    }
+    cv.notify_one ();
+    if (dispatch_thread.joinable ())
+    {
+        dispatch_thread.join ();
+    }
+    delete[] queue;
+}
+
+void DataSubscription::start ()
+{
+    keep_alive = true;
+    dispatch_thread = std::thread ([this] { this->dispatch (); });
+}
+
+size_t DataSubscription::get_depth (uint64_t write, uint64_t read)
+{
+    uint64_t depth = write - read;
+    return (depth > queue_size) ? queue_size : (size_t)depth;
+}
+
+void DataSubscription::push (const double *package)
+{
+    uint64_t write = write_pos.load (std::memory_order_relaxed);
+    // dont let writes to the slot become visible before previous position was published,
+    // dispatcher relies on it to detect overwritten packages
+    std::atomic_thread_fence (std::memory_order_release);
+    memcpy (queue + (write % queue_size) * num_rows, package, sizeof (double) * num_rows);
+    write_pos.store (write + 1, std::memory_order_release);
+
+    size_t depth = get_depth (write + 1, read_pos.load (std::memory_order_relaxed));
+    if (depth > max_lag.load (std::memory_order_relaxed))
+    {
+        max_lag.store (depth, std::memory_order_relaxed);
+    }
+    // pairs with the fence in dispatch: either dispatcher sees new write_pos or we see is_waiting
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if ((is_waiting.load (std::memory_order_relaxed)) && (depth >= (size_t)batch_size))
+    {
+        std::lock_guard<std::mutex> lk (m);
+        cv.notify_one ();
+    }
+}
+
+void DataSubscription::dispatch ()
+{
+    std::vector<double> packages ((size_t)batch_size * num_rows);
+    std::vector<double> batch ((size_t)batch_size * num_rows);
+    auto last_delivery = std::chrono::steady_clock::now ();
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lk (m);
+            is_waiting = true;
+            std::atomic_thread_fence (std::memory_order_seq_cst);
+            auto is_ready = [this] {
+                return (!keep_alive) ||
+                    (get_depth (write_pos.load (std::memory_order_acquire),
+                         read_pos.load (std::memory_order_relaxed)) >= (size_t)batch_size);
+            };
+            if (max_delay_ms > 0)
+            {
+                auto deadline = last_delivery + std::chrono::milliseconds (max_delay_ms);
+                cv.wait_until (lk, deadline, is_ready);
+            }
+            else
+            {
+                cv.wait (lk, is_ready);
+            }
+            is_waiting = false;
+        }
+
+        uint64_t read = read_pos.load (std::memory_order_relaxed);
+        uint64_t write = write_pos.load (std::memory_order_acquire);
+        if (read == write)
+        {
+            if (!keep_alive)
+            {
+                break;
+            }
+            last_delivery = std::chrono::steady_clock::now ();
+            continue;
+        }
+        // slot for position read is reused for position read + queue_size
+        if (write - read > queue_size)
+        {
+            num_dropped += write - read - queue_size;
+            read = write - queue_size;
+        }
+        int count = 0;
+        for (; (read < write) && (count < batch_size); read++)
+        {
+            memcpy (packages.data () + (size_t)count * num_rows,
+                queue + (read % queue_size) * num_rows, sizeof (double) * num_rows);
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (write_pos.load (std::memory_order_relaxed) - read >= queue_size)
+            {
+                num_dropped++;
+            }
+            else
+            {
+                count++;
+            }
+        }
+        read_pos.store (read, std::memory_order_release);
+        if (count == 0)
+        {
+            continue;
+        }
+        for (int channel = 0; channel < num_rows; channel++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                batch[(size_t)channel * count + i] = packages[(size_t)i * num_rows + channel];
+            }
+        }
+        callback (batch.data (), num_rows, count, user_data);
+        last_delivery = std::chrono::steady_clock::now ();
+    }
+}
+
+size_t DataSubscription::get_lag ()
+{
+    return get_depth (
+        write_pos.load (std::memory_order_acquire), read_pos.load (std::memory_order_acquire));
+}
+
+size_t DataSubscription::get_max_lag ()
+{
+    return max_lag.load (std::memory_order_relaxed);
+}
+
+uint64_t DataSubscription::get_num_dropped ()
+{
+    return num_dropped.load (std::memory_order_relaxed);
+}
@@ -4,12 +4,15 @@
 #include "file_streamer.h"
 
 
-FileStreamer::FileStreamer (const char *file, const char *file_mode, int data_len)
+FileStreamer::FileStreamer (const char *file, const char *file_mode, int data_len,
+    SampleFormat format, int timestamp_channel)
     : Streamer (data_len)
 {
     strcpy (this->file, file);
     strcpy (this->file_mode, file_mode);
     fp = NULL;
+    this->format = format;
+    this->timestamp_channel = timestamp_channel;
 }
 
 FileStreamer::~FileStreamer ()
@@ -38,9 +41,26 @@ int FileStreamer::init_streamer ()
 
 void FileStreamer::stream_data (double *data)
 {
-    for (int i = 0; i < len; i++)
+    if (format == SampleFormat::FLOAT32)
     {
-        fprintf (fp, "%lf,", data[i]);
+        for (int i = 0; i < len; i++)
+        {
+            if (i == timestamp_channel)
+            {
+                fprintf (fp, "%lf,", data[i]);
+            }
+            else
+            {
+                fprintf (fp, "%.7g,", (float)data[i]);
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < len; i++)
+        {
+            fprintf (fp, "%lf,", data[i]);
+        }
     }
     fputs ("\n", fp);
 }
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "custom_cast.h"
+#include "frame_decoder.h"
 #include "freeeeg32.h"
 #include "serial.h"
 #include "timestamp.h"
@@ -125,13 +126,17 @@ void FreeEEG32::read_thread ()
 {
     int res;
     constexpr int max_size = 200; // random value bigger than package size which is unknown
-    unsigned char b[max_size] = {0};
+    unsigned char *b = NULL;
+    int frame_size = 0;
     // dont know exact package size and it can be changed with new firmware versions, its >=
     // min_package_size and we can check start\stop bytes
     constexpr int min_package_size = 1 + 32 * 3;
+    // package is closed by end byte followed by start byte of the next one
+    FrameDecoder decoder (FreeEEG32::start_byte, FreeEEG32::end_byte, FreeEEG32::end_byte,
+        min_package_size + 1, max_size);
     float eeg_scale =
         FreeEEG32::ads_vref / float ((pow (2, 23) - 1)) / FreeEEG32::ads_gain * 1000000.;
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
@@ -139,45 +144,38 @@ void FreeEEG32::read_thread ()
     }
     bool first_package_received = false;
 
-    std::vector<int> eeg_channels = board_descr["eeg_channels"];
+    ChannelList eeg_channels = descr.eeg_channels;
 
     while (keep_alive)
     {
-        int pos = 0;
-        bool complete_package = false;
-        while ((keep_alive) && (pos < max_size - 2))
+        res = decoder.read_from (serial);
+        if (res == 0)
         {
-            res = serial->read_from_serial_port (b + pos, 1);
-            int prev_id = (pos <= 0) ? 0 : pos - 1;
-            if ((b[pos] == FreeEEG32::start_byte) && (b[prev_id] == FreeEEG32::end_byte) &&
-                (pos >= min_package_size))
-            {
-                complete_package = true;
-                break;
-            }
-            pos += res;
+            safe_logger (spdlog::level::trace, "unable to read from serial port");
+            continue;
         }
-        if (complete_package)
+        FrameStatus status;
+        while ((status = decoder.next_frame (&b, &frame_size)) != FrameStatus::NO_FRAME)
         {
+            if (status == FrameStatus::INVALID)
+            {
+                safe_logger (spdlog::level::trace, "no end byte in {} bytes", max_size);
+                continue;
+            }
             // handle the case that we start reading in the middle of data stream
             if (!first_package_received)
             {
                 first_package_received = true;
                 continue;
             }
-            package[board_descr["package_num_channel"].get<int> ()] = (double)b[0];
+            package[descr.package_num_channel] = (double)b[0];
             for (unsigned int i = 0; i < eeg_channels.size (); i++)
             {
                 package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (b + 1 + 3 * i);
             }
-            package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
+            package[descr.timestamp_channel] = get_timestamp ();
             push_package (package);
         }
-        else
-        {
-            safe_logger (
-                spdlog::level::trace, "stopped with pos: {}, keep_alive: {}", pos, keep_alive);
-        }
     }
     delete[] package;
 }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#include "streamer.h"
+
+#define DEFAULT_STREAMER_QUEUE_SIZE 8192
+#define WORKER_POLL_INTERVAL_MS 1
+
+
+enum class StreamerOverflowPolicy : int
+{
+    BLOCK = 0, // read thread waits until worker frees space in queue or streamer is interrupted
+    DROP = 1,  // the oldest packages are dropped for this streamer
+    COUNT = 2  // the oldest packages are dropped, number of dropped packages is logged
+};
+
+// destination of AsyncStreamer, fields are used by its worker thread and by producer
+struct StreamerWorker
+{
+    Streamer *streamer;
+    // blocking worker is switched to count if read thread stops waiting for it
+    std::atomic<StreamerOverflowPolicy> policy;
+    std::atomic<uint64_t> read_pos;
+    std::atomic<uint64_t> num_dropped;
+    std::atomic<size_t> max_queue_depth;
+    std::thread thread;
+};
+
+// runs streamers in their own threads, read thread copies package only once to a bounded queue
+// shared by all streamers and each streamer reads it with its own position, so slow disk or
+// network doesnt delay reading from device. Streamer with drop or count policy doesnt delay other
+// streamers, full queue of blocking streamer stops read thread and all of them
+class AsyncStreamer : public Streamer
+{
+
+public:
+    AsyncStreamer (int data_len, size_t queue_size);
+    ~AsyncStreamer ();
+
+    // takes ownership of streamer, should be called before init_streamer
+    void add_streamer (Streamer *streamer, StreamerOverflowPolicy policy);
+
+    int init_streamer ();
+    void stream_data (double *data);
+    // read thread stops waiting for blocking streamers, should be called before it's joined
+    void interrupt ();
+
+    size_t get_num_streamers ();
+    size_t get_queue_depth (size_t streamer_index);
+    size_t get_max_queue_depth (size_t streamer_index);
+    uint64_t get_num_dropped (size_t streamer_index);
+
+private:
+    std::vector<struct StreamerWorker *> workers;
+    double *queue;
+    size_t queue_size;
+    // monotonic position, slot in queue is position % queue_size
+    std::atomic<uint64_t> write_pos;
+
+    std::atomic<bool> keep_alive;
+    // used only to wake up workers on exit
+    std::mutex m;
+    std::condition_variable cv;
+    // read thread waits on it for blocking streamers, workers notify it only if it waits
+    std::atomic<bool> interrupted;
+    std::atomic<bool> producer_waiting;
+    std::mutex space_m;
+    std::condition_variable space_cv;
+
+    void wait_for_space (struct StreamerWorker *worker, uint64_t write);
+    void worker_thread (struct StreamerWorker *worker);
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "binary_file.h"
+#include "board_descriptor.h"
+#include "streamer.h"
+
+
+// writes packages to binary recording, see binary_file.h for format
+class BinaryFileStreamer : public Streamer
+{
+
+public:
+    BinaryFileStreamer (
+        const char *file, const char *file_mode, int board_id, const BoardDescriptor &descr);
+    ~BinaryFileStreamer ();
+
+    int init_streamer ();
+    void stream_data (double *data);
+
+private:
+    char file[128];
+    char file_mode[128];
+    int board_id;
+    int sampling_rate;
+    std::vector<int32_t> channel_map;
+    BinaryFileWriter writer;
+};
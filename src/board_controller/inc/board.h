@@ -1,21 +1,27 @@
 #pragma once
 
 #include <cmath>
-#include <deque>
 #include <limits>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "async_streamer.h"
 #include "board_controller.h"
+#include "board_descriptor.h"
 #include "brainflow_boards.h"
 #include "brainflow_constants.h"
 #include "brainflow_input_params.h"
 #include "data_buffer.h"
+#include "data_subscription.h"
+#include "mpsc_queue.h"
 #include "spinlock.h"
-#include "streamer.h"
 
 #include "spdlog/spdlog.h"
 
 #define MAX_CAPTURE_SAMPLES (86400 * 250) // should be enough for one day of capturing
+#define MAX_PENDING_MARKERS 1024
 
 
 class Board
@@ -30,6 +36,7 @@ public:
         skip_logs = true; // also should be set in inherited class destructor because it will be
                           // called before
         free_packages ();
+        free_subscriptions ();
     }
 
     Board (int board_id, struct BrainFlowInputParams params)
@@ -37,6 +44,8 @@ public:
         skip_logs = false;
         db = NULL;
         streamer = NULL;
+        next_subscription_id = 0;
+        pending_markers.reserve (MAX_PENDING_MARKERS);
         this->board_id = board_id;
         this->params = params;
     }
@@ -49,7 +58,31 @@ public:
     int get_current_board_data (int num_samples, double *data_buf, int *returned_samples);
     int get_board_data_count (int *result);
     int get_board_data (int data_count, double *data_buf);
-    int insert_marker (double value);
+    // marker with timestamp goes to the sample with the nearest timestamp(or to the next one if
+    // this sample was already pushed), marker without timestamp(0) goes to the next sample
+    int insert_marker (double value, double timestamp = 0.0);
+    int get_streamer_stats (
+        int streamer_index, int *queue_depth, int *max_queue_depth, int *num_dropped);
+    // read thread stops waiting for blocking streamers, called before stop_stream and release
+    void interrupt_streamer ();
+    // named readers which dont remove data for each other, cursor starts at the newest sample,
+    // cursors outlive start_stream/stop_stream and are moved to the beginning of new buffer
+    int add_reader_cursor (std::string name);
+    int remove_reader_cursor (std::string name);
+    int get_board_data_since (
+        std::string name, int max_samples, double *data_buf, int *returned_samples);
+    int get_reader_cursor_stats (std::string name, int *data_count, int *num_lost);
+    // subscriptions outlive start_stream/stop_stream and are removed by unsubscribe or release,
+    // callback must not call methods of the same session: unsubscribe waits for dispatch thread
+    int subscribe (board_data_callback callback, void *user_data, int batch_size,
+        int max_delay_ms, int *subscription_id);
+    int unsubscribe (int subscription_id);
+    int get_subscription_stats (int subscription_id, int *lag, int *max_lag, int *num_dropped);
+    // lets caller wait for data without holding session lock, NULL if stream was not started
+    std::shared_ptr<DataBuffer> get_data_buffer ()
+    {
+        return db;
+    }
 
     // Board::board_logger should not be called from destructors, to ensure that there are safe log
     // methods Board::board_logger still available but should be used only outside destructors
@@ -79,21 +112,58 @@ public:
     }
 
 protected:
-    DataBuffer *db;
+    std::shared_ptr<DataBuffer> db;
     bool skip_logs;
     int board_id;
     struct BrainFlowInputParams params;
-    Streamer *streamer;
+    AsyncStreamer *streamer;
     json board_descr;
+    // typed copy of board_descr, use it in read threads instead json lookups
+    struct BoardDescriptor descr;
+    // guards subscriptions
     SpinLock lock;
-    std::deque<double> marker_queue;
+    struct Marker
+    {
+        double value;
+        double timestamp;
+    };
+    MPSCQueue<struct Marker, MAX_PENDING_MARKERS> marker_queue;
+    // markers taken from queue by read thread but not attached yet, sorted by timestamp, capacity
+    // is reserved so read thread never allocates
+    std::vector<struct Marker> pending_markers;
+    // read thread pushes to them in push_package
+    std::map<int, DataSubscription *> subscriptions;
+    int next_subscription_id;
+    // used only from api methods which are serialized by session lock
+    struct ReaderCursor
+    {
+        uint64_t pos;
+        uint64_t num_lost;
+    };
+    std::map<std::string, struct ReaderCursor> reader_cursors;
 
     int prepare_for_acquisition (int buffer_size, char *streamer_params);
+    // called by prepare_for_acquisition after descr is built from brainflow_boards, boards with
+    // session specific settings(like sampling rate) update descr here
+    virtual void update_descr ()
+    {
+    }
     void free_packages ();
     void push_package (double *package);
+    int parse_streamer_options (std::string options, size_t *queue_size,
+        StreamerOverflowPolicy *policy, std::map<std::string, std::string> *streamer_options);
+    int pop_int_option (
+        std::map<std::string, std::string> &streamer_options, const char *key, int *value);
+    void parse_board_options (
+        std::string options, std::map<std::string, std::string> *board_options);
 
 private:
-    int prepare_streamer (char *streamer_params);
-    // reshapes data from DataBuffer format where all channels are mixed to linear buffer
-    void reshape_data (int data_count, const double *buf, double *output_buf);
+    int prepare_streamer (char *streamer_params, std::string *buffer_params);
+    int create_data_buffer (std::string params, int buffer_size);
+    void free_subscriptions ();
+    double pop_marker (const double *package);
+    int create_streamer (std::string streamer_params, Streamer **sync_streamer,
+        size_t *queue_size, StreamerOverflowPolicy *policy);
+    int pop_format_option (
+        std::map<std::string, std::string> &streamer_options, SampleFormat *format);
 };
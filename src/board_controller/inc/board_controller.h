@@ -11,6 +11,11 @@ extern "C"
     // I dont use const char * because I am not sure that all
     // languages support passing const char * instead char *
 
+    // receives batch in channel-major layout data[channel * num_samples + i], data is valid only
+    // during the call, called from dispatch thread of subscription
+    typedef void (*board_data_callback) (
+        double *data, int num_rows, int num_samples, void *user_data);
+
     // data acquisition methods
     SHARED_EXPORT int CALLING_CONVENTION prepare_session (
         int board_id, char *json_brainflow_input_params);
@@ -32,6 +37,81 @@ extern "C"
         int *prepared, int board_id, char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION insert_marker (
         double marker_value, int board_id, char *json_brainflow_input_params);
+    // marker goes to the sample with the nearest timestamp, timestamp is in the same clock as
+    // timestamp channel(unix time in seconds)
+    SHARED_EXPORT int CALLING_CONVENTION insert_marker_with_timestamp (double marker_value,
+        double timestamp, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_streamer_stats (int streamer_index, int *queue_depth,
+        int *max_queue_depth, int *num_dropped, int board_id, char *json_brainflow_input_params);
+    // blocks until buffer has at least min_samples, returns SYNC_TIMEOUT_ERROR after timeout_ms
+    SHARED_EXPORT int CALLING_CONVENTION wait_for_board_data (
+        int min_samples, int timeout_ms, int board_id, char *json_brainflow_input_params);
+    // named readers of the same buffer, get_board_data_since returns samples added after previous
+    // call for this cursor and doesnt remove them for get_board_data and other cursors
+    SHARED_EXPORT int CALLING_CONVENTION add_reader_cursor (
+        char *cursor_name, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION remove_reader_cursor (
+        char *cursor_name, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_since (char *cursor_name, int max_samples,
+        double *data_buf, int *returned_samples, int board_id, char *json_brainflow_input_params);
+    // num_lost counts samples overwritten before this cursor read them
+    SHARED_EXPORT int CALLING_CONVENTION get_reader_cursor_stats (char *cursor_name,
+        int *data_count, int *num_lost, int board_id, char *json_brainflow_input_params);
+    // callback gets batches of batch_size samples or less if there were no batches for
+    // max_delay_ms(0 to deliver only complete batches), callback must not call methods of this
+    // board
+    SHARED_EXPORT int CALLING_CONVENTION subscribe_board_data (board_data_callback callback,
+        void *user_data, int batch_size, int max_delay_ms, int *subscription_id, int board_id,
+        char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION unsubscribe_board_data (
+        int subscription_id, int board_id, char *json_brainflow_input_params);
+    // lag is number of samples queued for callback, num_dropped counts samples overwritten before
+    // delivery
+    SHARED_EXPORT int CALLING_CONVENTION get_subscription_stats (int subscription_id, int *lag,
+        int *max_lag, int *num_dropped, int board_id, char *json_brainflow_input_params);
+
+    // data acquisition methods by session handle, handle is resolved in O(1) without parsing
+    // json, use them for frequently called methods
+    SHARED_EXPORT int CALLING_CONVENTION prepare_session_handle (
+        int *session_handle, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_session_handle (
+        int *session_handle, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION start_stream_by_handle (
+        int buffer_size, char *streamer_params, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION stop_stream_by_handle (int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION release_session_by_handle (int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_current_board_data_by_handle (
+        int num_samples, double *data_buf, int *returned_samples, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_count_by_handle (
+        int *result, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_by_handle (
+        int data_count, double *data_buf, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION config_board_by_handle (
+        char *config, char *response, int *response_len, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION is_prepared_by_handle (int *prepared, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION insert_marker_by_handle (
+        double marker_value, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION insert_marker_with_timestamp_by_handle (
+        double marker_value, double timestamp, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_streamer_stats_by_handle (int streamer_index,
+        int *queue_depth, int *max_queue_depth, int *num_dropped, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION wait_for_board_data_by_handle (
+        int min_samples, int timeout_ms, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION add_reader_cursor_by_handle (
+        char *cursor_name, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION remove_reader_cursor_by_handle (
+        char *cursor_name, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_since_by_handle (char *cursor_name,
+        int max_samples, double *data_buf, int *returned_samples, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_reader_cursor_stats_by_handle (
+        char *cursor_name, int *data_count, int *num_lost, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION subscribe_board_data_by_handle (
+        board_data_callback callback, void *user_data, int batch_size, int max_delay_ms,
+        int *subscription_id, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION unsubscribe_board_data_by_handle (
+        int subscription_id, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_subscription_stats_by_handle (int subscription_id,
+        int *lag, int *max_lag, int *num_dropped, int session_handle);
 
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level (int log_level);
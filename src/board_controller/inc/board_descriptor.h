@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+#define MAX_CHANNELS_PER_TYPE 64
+
+
+// fixed size list of row indices for one data type, empty if board has no such data
+struct ChannelList
+{
+    int channels[MAX_CHANNELS_PER_TYPE];
+    size_t len;
+
+    ChannelList ()
+    {
+        len = 0;
+    }
+
+    size_t size () const
+    {
+        return len;
+    }
+
+    int operator[] (size_t index) const
+    {
+        return channels[index];
+    }
+
+    const int *begin () const
+    {
+        return channels;
+    }
+
+    const int *end () const
+    {
+        return channels + len;
+    }
+};
+
+// typed copy of board description from brainflow_boards_json, it's built once before streaming
+// to avoid json lookups for each package in read threads, -1 means that board has no such row
+struct BoardDescriptor
+{
+    int num_rows;
+    int sampling_rate;
+    int package_num_channel;
+    int timestamp_channel;
+    int marker_channel;
+    int battery_channel;
+    ChannelList eeg_channels;
+    ChannelList emg_channels;
+    ChannelList ecg_channels;
+    ChannelList eog_channels;
+    ChannelList accel_channels;
+    ChannelList gyro_channels;
+    ChannelList analog_channels;
+    ChannelList eda_channels;
+    ChannelList ppg_channels;
+    ChannelList temperature_channels;
+    ChannelList resistance_channels;
+    ChannelList other_channels;
+
+    BoardDescriptor ()
+    {
+        num_rows = 0;
+        sampling_rate = -1;
+        package_num_channel = -1;
+        timestamp_channel = -1;
+        marker_channel = -1;
+        battery_channel = -1;
+    }
+
+    // returns BrainFlowExitCodes, throws nothing
+    int init (const json &board_descr);
+};
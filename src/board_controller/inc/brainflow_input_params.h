@@ -42,7 +42,8 @@ struct BrainFlowInputParams
         return std::tie (serial_port, mac_address, ip_address, ip_port, ip_protocol, other_info,
                    timeout, serial_number, file) <
             std::tie (other.serial_port, other.mac_address, other.ip_address, other.ip_port,
-                other.ip_protocol, other.other_info, timeout, serial_number, file);
+                other.ip_protocol, other.other_info, other.timeout, other.serial_number,
+                other.file);
     }
 
     bool operator> (const struct BrainFlowInputParams &other) const
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+
+#include "board_controller.h"
+
+#define DEFAULT_SUBSCRIPTION_QUEUE_SIZE 8192
+
+
+// delivers packages pushed by board read thread to user callback from its own dispatch thread,
+// packages are collected to batches of batch_size, incomplete batch is delivered if there were no
+// deliveries for max_delay_ms(0 means wait for complete batch). Batch is channel-major:
+// data[channel * num_samples + sample]. Read thread never waits for callback: if callback is too
+// slow the oldest packages are dropped and counted
+class DataSubscription
+{
+
+public:
+    DataSubscription (int num_rows, board_data_callback callback, void *user_data, int batch_size,
+        int max_delay_ms);
+    // stops dispatch thread, packages which are already queued are delivered before exit
+    ~DataSubscription ();
+
+    void start ();
+    // called only from board read thread, never blocks
+    void push (const double *package);
+
+    size_t get_lag ();
+    size_t get_max_lag ();
+    uint64_t get_num_dropped ();
+
+private:
+    int num_rows;
+    board_data_callback callback;
+    void *user_data;
+    int batch_size;
+    int max_delay_ms;
+
+    // ring of row-major packages, slot is position % queue_size
+    double *queue;
+    size_t queue_size;
+    std::atomic<uint64_t> write_pos;
+    std::atomic<uint64_t> read_pos;
+    std::atomic<size_t> max_lag;
+    std::atomic<uint64_t> num_dropped;
+
+    std::thread dispatch_thread;
+    std::atomic<bool> keep_alive;
+    // producer locks it only if dispatcher sleeps and batch is complete
+    std::atomic<bool> is_waiting;
+    std::mutex m;
+    std::condition_variable cv;
+
+    void dispatch ();
+    size_t get_depth (uint64_t write, uint64_t read);
+};
@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 
+#include "sample_format.h"
 #include "streamer.h"
 
 
@@ -9,7 +10,9 @@ class FileStreamer : public Streamer
 {
 
 public:
-    FileStreamer (const char *file, const char *file_mode, int data_len);
+    // with SampleFormat::FLOAT32 channels except timestamp are written with float precision
+    FileStreamer (const char *file, const char *file_mode, int data_len,
+        SampleFormat format = SampleFormat::FLOAT64, int timestamp_channel = -1);
     ~FileStreamer ();
 
     int init_streamer ();
@@ -19,4 +22,6 @@ private:
     char file[128];
     char file_mode[128];
     FILE *fp;
+    SampleFormat format;
+    int timestamp_channel;
 };
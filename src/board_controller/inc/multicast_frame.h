@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+#define MULTICAST_FRAME_MAGIC 0x4642
+// version 0 is the old protocol: one package per datagram without header
+#define MULTICAST_LEGACY_VERSION 0
+#define MULTICAST_FRAME_VERSION 1
+// ethernet mtu without ip and udp headers, frames fit it unless bigger batch is requested
+#define MULTICAST_MAX_PAYLOAD_SIZE 1472
+#define MULTICAST_MAX_DATAGRAM_SIZE 65507
+#define DEFAULT_MULTICAST_FLUSH_INTERVAL_MS 10
+
+
+// datagram of streaming_board streamer is MultiCastFrameHeader followed by num_samples packages,
+// each of them is num_rows doubles, native byte order. seq is number of the first package in
+// frame since start of streaming, receiver uses it to detect lost packages. Legacy datagrams
+// are exactly num_rows doubles without header, float32 frame with one package of 6 or 7 rows has
+// the same size, so receiver checks magic and version first and uses size only without them.
+// With SampleFormat::FLOAT32 package is packed by SampleLayout: timestamp_channel as double
+// followed by other channels as floats
+struct MultiCastFrameHeader
+{
+    uint16_t magic;
+    uint8_t version;
+    uint8_t sample_format; // SampleFormat
+    int32_t board_id;
+    uint64_t seq;
+    uint16_t num_samples;
+    uint16_t num_rows;
+    int32_t timestamp_channel; // used only by SampleFormat::FLOAT32
+};
@@ -1,22 +1,48 @@
 #pragma once
 
+#include <chrono>
+#include <stdint.h>
+
+#include "multicast_frame.h"
 #include "multicast_server.h"
+#include "sample_format.h"
 
 #include "streamer.h"
 
 
+// packs packages to frames described in multicast_frame.h, frame is sent when it has batch_size
+// packages or when the oldest package in it waits longer than flush_interval_ms
 class MultiCastStreamer : public Streamer
 {
 
 public:
-    MultiCastStreamer (const char *ip, int port, int data_len);
+    // batch_size <= 0 means as many packages as fit to MULTICAST_MAX_PAYLOAD_SIZE
+    MultiCastStreamer (const char *ip, int port, int board_id, int data_len,
+        int version = MULTICAST_FRAME_VERSION, int batch_size = 0,
+        int flush_interval_ms = DEFAULT_MULTICAST_FLUSH_INTERVAL_MS,
+        SampleFormat format = SampleFormat::FLOAT64, int timestamp_channel = -1);
     ~MultiCastStreamer ();
 
     int init_streamer ();
     void stream_data (double *data);
+    void on_idle ();
 
 private:
     char ip[128];
     int port;
+    int board_id;
+    int version;
+    int batch_size;
+    int flush_interval_ms;
     MultiCastServer *server;
+    SampleLayout package_layout;
+    int timestamp_channel;
+    int package_size;
+
+    char *frame;
+    int num_in_frame;
+    uint64_t seq;
+    std::chrono::steady_clock::time_point first_package_time;
+
+    void send_frame ();
 };
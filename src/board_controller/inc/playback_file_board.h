@@ -2,12 +2,18 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <stdint.h>
 #include <thread>
+#include <vector>
 
 #include "board.h"
+#include "binary_file.h"
 #include "board_controller.h"
+#include "sample_clock.h"
 
 
+// other_info is board_id of recording board[&batch_size=packages pushed at once], other options
+// are ignored
 class PlaybackFileBoard : public Board
 {
 
@@ -21,8 +27,42 @@ private:
     std::mutex m;
     std::condition_variable cv;
     volatile int state;
+    bool is_binary;
+    int batch_size;
+    // used only by read thread, offsets are in ns from start of streaming
+    SampleClock clock;
+    bool new_timestamps;
+    double file_base;     // timestamp from file at offset_base, < 0 after start or loop restart
+    int64_t offset_base;
+    int64_t last_offset;
+    std::vector<double> batch;
+    int batch_len;
+    // loaded in prepare_session and kept across streams
+    int num_rows;
+    std::vector<double> samples; // whole csv file, row-major
+    int64_t csv_offset;          // end of parsed part of csv file
+    BinaryFileReader binary_reader;
+    std::vector<int64_t> block_starts; // index of the first sample of each block and total count
+    // binary blocks are read lazily by read thread, only the current one is kept row-major
+    std::vector<double> block_buf;
+    std::vector<double> block_samples;
+    size_t cur_block;
+    // speed and seek are set by config_board during streaming, seek params are guarded by m
+    volatile double speed;
+    volatile bool seek_pending;
+    bool seek_by_timestamp;
+    double seek_value;
 
     void read_thread ();
+    int64_t load_csv_rows ();
+    int load_binary_file ();
+    size_t get_num_samples () const;
+    const double *get_sample (size_t pos);
+    int parse_options ();
+    size_t get_seek_pos ();
+    void restart_timeline (int64_t gap_ns);
+    void push_with_delay (const double *package, double current_speed);
+    void flush_batch ();
 
 public:
     PlaybackFileBoard (struct BrainFlowInputParams params);
@@ -14,6 +14,11 @@ public:
 
     virtual int init_streamer () = 0;
     virtual void stream_data (double *data) = 0;
+    // called from streamer thread when there are no new packages, streamers which collect
+    // packages before sending can flush them here
+    virtual void on_idle ()
+    {
+    }
 
 protected:
     int len;
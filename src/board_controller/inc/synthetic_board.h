@@ -5,7 +5,15 @@
 #include "board.h"
 #include "board_controller.h"
 
+#define SYNTHETIC_TABLE_SIZE 4096 // power of two
 
+
+// other_info may hold options separated by '&' to stress acquisition pipeline without hardware:
+// sampling_rate=Hz, num_channels=filled exg channels(up to get_eeg_channels size, other exg rows
+// are zero), batch_size=packages pushed at once, unthrottled=1 pushes as fast as possible. Row
+// layout is always the one from get_num_rows, get_sampling_rate reports default rate and
+// config_board ("get_sampling_rate") returns the one used by session. Other parts of other_info
+// are ignored
 class SyntheticBoard : public Board
 {
 
@@ -14,8 +22,18 @@ private:
     bool initialized;
     bool is_streaming;
     std::thread streaming_thread;
+    int sampling_rate;
+    int num_channels;
+    int batch_size;
+    bool unthrottled;
+    // one period of sine, read thread doesnt call sin
+    double sin_table[SYNTHETIC_TABLE_SIZE];
 
     void read_thread ();
+    int parse_options ();
+
+protected:
+    void update_descr ();
 
 public:
     SyntheticBoard (struct BrainFlowInputParams params);
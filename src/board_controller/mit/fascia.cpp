@@ -137,13 +137,13 @@ void Fascia::read_thread ()
 {
     int res;
     unsigned char b[Fascia::transaction_size];
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
         package[i] = 0.0;
     }
-    std::vector<int> eeg_channels = board_descr["eeg_channels"];
+    ChannelList eeg_channels = descr.eeg_channels;
 
     while (keep_alive)
     {
@@ -186,25 +186,25 @@ void Fascia::read_thread ()
             int offset = cur_package * Fascia::package_size;
             int32_t package_num = 0;
             memcpy (&package_num, b + offset, 4);
-            package[board_descr["package_num_channel"].get<int> ()] = (double)package_num;
+            package[descr.package_num_channel] = (double)package_num;
             int32_t valid = 0;
             memcpy (&valid, b + 4 + offset, 4);
-            package[board_descr["other_channels"][0].get<int> ()] = (double)valid;
+            package[descr.other_channels[0]] = (double)valid;
             for (int i = 2, counter = 0; i < 10; i++, counter++)
             {
                 float val;
                 // sends data in volts
                 memcpy (&val, b + offset + 8 + (i - 2) * 4, 4);
-                package[board_descr["eeg_channels"][counter].get<int> ()] = 1000000.0 * val;
+                package[descr.eeg_channels[counter]] = 1000000.0 * val;
             }
             for (int i = 10, counter = 0; i < 13; i++, counter++)
             {
-                package[board_descr["accel_channels"][counter].get<int> ()] =
+                package[descr.accel_channels[counter]] =
                     accel_scale * cast_16bit_to_int32 (b + offset + 40 + (i - 10) * 2);
             }
             for (int i = 13, counter = 0; i < 16; i++, counter++)
             {
-                package[board_descr["gyro_channels"][counter].get<int> ()] =
+                package[descr.gyro_channels[counter]] =
                     accel_scale * cast_16bit_to_int32 (b + offset + 40 + (i - 10) * 2);
             }
 
@@ -213,10 +213,10 @@ void Fascia::read_thread ()
             memcpy (&temperature, b + offset + 56, 4);
             memcpy (&ppg, b + offset + 60, 4);
             memcpy (&timestamp, b + offset + 64, 4);
-            package[board_descr["eda_channels"][0].get<int> ()] = (double)eda;
-            package[board_descr["temperature_channels"][0].get<int> ()] = (double)temperature;
-            package[board_descr["ppg_channels"][0].get<int> ()] = (double)ppg;
-            package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
+            package[descr.eda_channels[0]] = (double)eda;
+            package[descr.temperature_channels[0]] = (double)temperature;
+            package[descr.ppg_channels[0]] = (double)ppg;
+            package[descr.timestamp_channel] = get_timestamp ();
 
             push_package (package);
         }
@@ -6,24 +6,61 @@
 #include "multicast_streamer.h"
 
 
-MultiCastStreamer::MultiCastStreamer (const char *ip, int port, int data_len) : Streamer (data_len)
+MultiCastStreamer::MultiCastStreamer (const char *ip, int port, int board_id, int data_len,
+    int version, int batch_size, int flush_interval_ms, SampleFormat format, int timestamp_channel)
+    : Streamer (data_len), package_layout (data_len, 1, format, timestamp_channel)
 {
     strcpy (this->ip, ip);
     this->port = port;
+    this->board_id = board_id;
+    this->version = version;
+    this->batch_size = batch_size;
+    this->flush_interval_ms = flush_interval_ms;
     server = NULL;
+    frame = NULL;
+    num_in_frame = 0;
+    seq = 0;
+    this->timestamp_channel = timestamp_channel;
+    package_size = (int)package_layout.get_size ();
 }
 
 MultiCastStreamer::~MultiCastStreamer ()
 {
     if (server != NULL)
     {
+        if (num_in_frame > 0)
+        {
+            send_frame ();
+        }
         delete server;
         server = NULL;
     }
+    delete[] frame;
+    frame = NULL;
 }
 
 int MultiCastStreamer::init_streamer ()
 {
+    if ((version != MULTICAST_LEGACY_VERSION) && (version != MULTICAST_FRAME_VERSION))
+    {
+        Board::board_logger->error ("unsupported multicast protocol version {}", version);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((version == MULTICAST_LEGACY_VERSION) &&
+        (package_layout.get_format () != SampleFormat::FLOAT64))
+    {
+        Board::board_logger->error ("legacy multicast protocol supports only float64 format");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int header_size = (int)sizeof (struct MultiCastFrameHeader);
+    int max_batch_size = (MULTICAST_MAX_DATAGRAM_SIZE - header_size) / package_size;
+    if (batch_size <= 0)
+    {
+        batch_size = (MULTICAST_MAX_PAYLOAD_SIZE - header_size) / package_size;
+    }
+    batch_size = (batch_size > max_batch_size) ? max_batch_size : batch_size;
+    batch_size = (batch_size < 1) ? 1 : batch_size;
+
     server = new MultiCastServer (ip, port);
     int res = server->init ();
     if (res != (int)MultiCastReturnCodes::STATUS_OK)
@@ -31,10 +68,65 @@ int MultiCastStreamer::init_streamer ()
         Board::board_logger->error ("failed to init server multicast socket {}", res);
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
+    if (version == MULTICAST_FRAME_VERSION)
+    {
+        frame = new char[header_size + batch_size * package_size];
+        struct MultiCastFrameHeader header;
+        memset (&header, 0, sizeof (header));
+        header.magic = MULTICAST_FRAME_MAGIC;
+        header.version = MULTICAST_FRAME_VERSION;
+        header.sample_format = (uint8_t)package_layout.get_format ();
+        header.timestamp_channel = timestamp_channel;
+        header.board_id = board_id;
+        header.num_rows = (uint16_t)len;
+        memcpy (frame, &header, sizeof (header));
+        Board::board_logger->debug (
+            "multicast batch size {}, flush interval {} ms", batch_size, flush_interval_ms);
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 void MultiCastStreamer::stream_data (double *data)
 {
-    server->send (data, sizeof (double) * len);
+    if (version == MULTICAST_LEGACY_VERSION)
+    {
+        server->send (data, sizeof (double) * len);
+        return;
+    }
+    if (num_in_frame == 0)
+    {
+        first_package_time = std::chrono::steady_clock::now ();
+    }
+    package_layout.write (
+        frame + sizeof (struct MultiCastFrameHeader) + package_size * num_in_frame, 0, data);
+    num_in_frame++;
+    if (num_in_frame == batch_size)
+    {
+        send_frame ();
+    }
+    else
+    {
+        on_idle ();
+    }
+}
+
+void MultiCastStreamer::on_idle ()
+{
+    if ((num_in_frame > 0) &&
+        (std::chrono::steady_clock::now () - first_package_time >=
+            std::chrono::milliseconds (flush_interval_ms)))
+    {
+        send_frame ();
+    }
+}
+
+void MultiCastStreamer::send_frame ()
+{
+    struct MultiCastFrameHeader *header = (struct MultiCastFrameHeader *)frame;
+    header->seq = seq;
+    header->num_samples = (uint16_t)num_in_frame;
+    server->send (
+        frame, (int)(sizeof (struct MultiCastFrameHeader) + package_size * num_in_frame));
+    seq += num_in_frame;
+    num_in_frame = 0;
 }
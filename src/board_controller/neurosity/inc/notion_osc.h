@@ -8,6 +8,7 @@
 #include "board.h"
 #include "board_controller.h"
 #include "broadcast_client.h"
+#include "notion_osc_parser.h"
 
 #include <oscpp/client.hpp>
 #include <oscpp/server.hpp>
@@ -27,7 +28,8 @@ private:
     volatile int state;
     void read_thread ();
 
-    void handle_packet (double *package, const OSCPP::Server::Packet &packet);
+    void handle_packet (
+        NotionOSCParser &parser, double *package, const OSCPP::Server::Packet &packet);
 
 public:
     NotionOSC (struct BrainFlowInputParams params);
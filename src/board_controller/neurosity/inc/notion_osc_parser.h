@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+
+#include "board_descriptor.h"
+
+#include <oscpp/server.hpp>
+
+
+enum class NotionOSCMessage : int
+{
+    RAW = 0,
+    UNKNOWN_ADDRESS = 1,
+    OTHER_DEVICE = 2,
+    WRONG_TIMESTAMP = 3,
+    // package is filled, but marker is not numeric and ignored
+    WRONG_MARKER = 4
+};
+
+
+// decodes /raw messages from Notion directly into package without allocations, address and serial
+// number are matched as raw bytes and numbers are parsed in place. OSCPP throws OSCPP::Error
+// only if message is malformed
+class NotionOSCParser
+{
+
+public:
+    NotionOSCParser (const struct BoardDescriptor &descr, const std::string &serial_number);
+
+    NotionOSCMessage decode (const OSCPP::Server::Message &msg, double *package);
+    // number of eeg values in the last raw message, notion sends 8
+    int get_num_eeg_values () const
+    {
+        return num_eeg_values;
+    }
+
+private:
+    // copies, parser may outlive board fields it was built from
+    struct BoardDescriptor descr;
+    std::string serial_number;
+    int num_eeg_values;
+};
@@ -133,8 +133,9 @@ void NotionOSC::read_thread ()
 {
     int res;
     constexpr int max_package_size = 8192;
-    unsigned char b[max_package_size];
-    int num_rows = board_descr["num_rows"];
+    DatagramBatch batch (max_package_size, 32);
+    NotionOSCParser parser (descr, params.serial_number);
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
@@ -143,7 +144,7 @@ void NotionOSC::read_thread ()
 
     while (keep_alive)
     {
-        res = socket->recv (b, max_package_size);
+        res = socket->recv_batch (&batch);
         if (res == -1)
         {
 #ifdef _WIN32
@@ -153,33 +154,37 @@ void NotionOSC::read_thread ()
 #endif
             continue;
         }
-        else
+        if (state != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            if (state != (int)BrainFlowExitCodes::STATUS_OK)
+            safe_logger (spdlog::level::info,
+                "received first package with {} bytes streaming is started", batch.get_size (0));
             {
-                safe_logger (spdlog::level::info,
-                    "received first package with {} bytes streaming is started", res);
-                {
-                    std::lock_guard<std::mutex> lk (m);
-                    state = (int)BrainFlowExitCodes::STATUS_OK;
-                }
-                cv.notify_one ();
-                safe_logger (spdlog::level::debug, "start streaming");
+                std::lock_guard<std::mutex> lk (m);
+                state = (int)BrainFlowExitCodes::STATUS_OK;
             }
+            cv.notify_one ();
+            safe_logger (spdlog::level::debug, "start streaming");
+        }
+        for (int i = 0; i < res; i++)
+        {
+            // OSCPP throws only for malformed packets
             try
             {
-                handle_packet (package, OSCPP::Server::Packet (b, res));
+                handle_packet (parser, package,
+                    OSCPP::Server::Packet (batch.get_datagram (i), batch.get_size (i)));
             }
-            catch (...)
+            catch (const std::exception &e)
             {
-                // do nothing
+                safe_logger (
+                    spdlog::level::trace, "Exception in parsing OSC packet: {}", e.what ());
             }
         }
     }
     delete[] package;
 }
 
-void NotionOSC::handle_packet (double *package, const OSCPP::Server::Packet &packet)
+void NotionOSC::handle_packet (
+    NotionOSCParser &parser, double *package, const OSCPP::Server::Packet &packet)
 {
     if (packet.isBundle ())
     {
@@ -187,71 +192,38 @@ void NotionOSC::handle_packet (double *package, const OSCPP::Server::Packet &pac
         OSCPP::Server::PacketStream packets (bundle.packets ());
         while (!packets.atEnd ())
         {
-            handle_packet (package, packets.next ());
+            handle_packet (parser, package, packets.next ());
         }
+        return;
     }
-    else
-    {
-        OSCPP::Server::Message msg (packet);
-        std::string msg_address = std::string (msg.address ());
-        OSCPP::Server::ArgStream args (msg.args ());
-        if ((msg_address.size () > 3) &&
-            (msg_address.compare (msg_address.size () - 3, 3, "raw") == 0))
-        {
-            // check serial number if provided
-            if (!params.serial_number.empty ())
-            {
-                if (msg_address.find (params.serial_number) == std::string::npos)
-                {
-                    safe_logger (spdlog::level::trace,
-                        "found package from different device. Check provided serial number");
-                    return;
-                }
-            }
 
-            // parse data
-            try
+    OSCPP::Server::Message msg (packet);
+    NotionOSCMessage res = parser.decode (msg, package);
+    switch (res)
+    {
+        case NotionOSCMessage::RAW:
+        case NotionOSCMessage::WRONG_MARKER:
+            if (parser.get_num_eeg_values () != 8)
             {
-                OSCPP::Server::ArgStream eeg_data (args.array ());
-                int counter = 0;
-                while (!eeg_data.atEnd ())
-                {
-                    package[board_descr["eeg_channels"][counter].get<int> ()] =
-                        (double)eeg_data.float32 ();
-                    counter++;
-                }
-                if (counter != 8)
-                {
-                    safe_logger (spdlog::level::trace,
-                        "wrong format for eeg data, must be 8 values, found {}", counter);
-                }
-                std::string timestamp_str = args.string ();
-                package[board_descr["timestamp_channel"].get<int> ()] = std::stod (timestamp_str);
-                package[board_descr["package_num_channel"].get<int> ()] = (double)args.int32 ();
-                std::string marker = std::string (args.string ());
-                if (!marker.empty ())
-                {
-                    try
-                    {
-                        package[board_descr["other_channels"][0].get<int> ()] = std::stod (marker);
-                    }
-                    catch (...)
-                    {
-                        safe_logger (
-                            spdlog::level::err, "For BrainFlow marker should be numeric value.");
-                    }
-                }
-                push_package (package);
+                safe_logger (spdlog::level::trace,
+                    "wrong format for eeg data, must be 8 values, found {}",
+                    parser.get_num_eeg_values ());
             }
-            catch (std::exception &e)
+            if (res == NotionOSCMessage::WRONG_MARKER)
             {
-                safe_logger (
-                    spdlog::level::trace, "Exception in parsing OSC packet: {}", e.what ());
+                safe_logger (spdlog::level::err, "For BrainFlow marker should be numeric value.");
             }
-        }
-        else
-        {
-            safe_logger (spdlog::level::trace, "Unknown msg: {}", msg_address.c_str ());
-        }
+            push_package (package);
+            break;
+        case NotionOSCMessage::OTHER_DEVICE:
+            safe_logger (spdlog::level::trace,
+                "found package from different device. Check provided serial number");
+            break;
+        case NotionOSCMessage::WRONG_TIMESTAMP:
+            safe_logger (spdlog::level::trace, "wrong timestamp in OSC packet");
+            break;
+        default:
+            safe_logger (spdlog::level::trace, "Unknown msg: {}", msg.address ());
+            break;
     }
 }
@@ -0,0 +1,65 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "notion_osc_parser.h"
+
+#define NOTION_OSC_RAW_SUFFIX "raw"
+#define NOTION_OSC_RAW_SUFFIX_LEN (sizeof (NOTION_OSC_RAW_SUFFIX) - 1)
+
+
+NotionOSCParser::NotionOSCParser (
+    const struct BoardDescriptor &descr, const std::string &serial_number)
+    : descr (descr), serial_number (serial_number)
+{
+    num_eeg_values = 0;
+}
+
+NotionOSCMessage NotionOSCParser::decode (const OSCPP::Server::Message &msg, double *package)
+{
+    const char *address = msg.address ();
+    size_t address_len = strlen (address);
+    if ((address_len <= NOTION_OSC_RAW_SUFFIX_LEN) ||
+        (memcmp (address + address_len - NOTION_OSC_RAW_SUFFIX_LEN, NOTION_OSC_RAW_SUFFIX,
+             NOTION_OSC_RAW_SUFFIX_LEN) != 0))
+    {
+        return NotionOSCMessage::UNKNOWN_ADDRESS;
+    }
+    if ((!serial_number.empty ()) && (strstr (address, serial_number.c_str ()) == NULL))
+    {
+        return NotionOSCMessage::OTHER_DEVICE;
+    }
+
+    OSCPP::Server::ArgStream args (msg.args ());
+    OSCPP::Server::ArgStream eeg_data (args.array ());
+    num_eeg_values = 0;
+    while (!eeg_data.atEnd ())
+    {
+        float value = eeg_data.float32 ();
+        if ((size_t)num_eeg_values < descr.eeg_channels.size ())
+        {
+            package[descr.eeg_channels[num_eeg_values]] = (double)value;
+        }
+        num_eeg_values++;
+    }
+    // strings are null terminated inside of datagram, no need to copy them
+    const char *timestamp_str = args.string ();
+    char *end = NULL;
+    double timestamp = strtod (timestamp_str, &end);
+    if (end == timestamp_str)
+    {
+        return NotionOSCMessage::WRONG_TIMESTAMP;
+    }
+    package[descr.timestamp_channel] = timestamp;
+    package[descr.package_num_channel] = (double)args.int32 ();
+    const char *marker_str = args.string ();
+    if (marker_str[0] != '\0')
+    {
+        double marker = strtod (marker_str, &end);
+        if (end == marker_str)
+        {
+            return NotionOSCMessage::WRONG_MARKER;
+        }
+        package[descr.other_channels[0]] = marker;
+    }
+    return NotionOSCMessage::RAW;
+}
@@ -2,6 +2,7 @@
 
 #include "custom_cast.h"
 #include "cyton.h"
+#include "frame_decoder.h"
 #include "serial.h"
 #include "timestamp.h"
 
@@ -9,6 +10,7 @@
 #define END_BYTE_STANDARD 0xC0
 #define END_BYTE_ANALOG 0xC1
 #define END_BYTE_MAX 0xC6
+#define PACKAGE_SIZE 33
 
 
 void Cyton::read_thread ()
@@ -28,96 +30,84 @@ void Cyton::read_thread ()
         Byte 33: 0xCX where X is 0-F in hex
     */
     int res;
-    unsigned char b[32];
+    unsigned char *b = NULL;
+    int frame_size = 0;
+    FrameDecoder decoder (START_BYTE, END_BYTE_STANDARD, END_BYTE_MAX, PACKAGE_SIZE, PACKAGE_SIZE);
     double accel[3] = {0.};
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
         package[i] = 0.0;
     }
-    std::vector<int> eeg_channels = board_descr["eeg_channels"];
+    ChannelList eeg_channels = descr.eeg_channels;
 
     while (keep_alive)
     {
-        // check start byte
-        res = serial->read_from_serial_port (b, 1);
-        if (res != 1)
+        // read everything available and decode all complete packages
+        res = decoder.read_from (serial);
+        if (res == 0)
         {
-            safe_logger (spdlog::level::debug, "unable to read 1 byte");
+            safe_logger (spdlog::level::debug, "unable to read from serial port");
             continue;
         }
-        if (b[0] != START_BYTE)
+        FrameStatus status;
+        while ((status = decoder.next_frame (&b, &frame_size)) != FrameStatus::NO_FRAME)
         {
-            continue;
-        }
+            if (status == FrameStatus::INVALID)
+            {
+                safe_logger (spdlog::level::warn, "Wrong end byte {}", b[31]);
+                continue;
+            }
 
-        int remaining_bytes = 32;
-        int pos = 0;
-        while ((remaining_bytes > 0) && (keep_alive))
-        {
-            res = serial->read_from_serial_port (b + pos, remaining_bytes);
-            remaining_bytes -= res;
-            pos += res;
-        }
-        if (!keep_alive)
-        {
-            break;
-        }
+            // package num
+            package[descr.package_num_channel] = (double)b[0];
+            // eeg
+            for (unsigned int i = 0; i < eeg_channels.size (); i++)
+            {
+                package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (b + 1 + 3 * i);
+            }
+            // end byte
+            package[descr.other_channels[0]] = (double)b[31];
+            // place unprocessed bytes for all modes to other_channels
+            package[descr.other_channels[1]] = (double)b[25];
+            package[descr.other_channels[2]] = (double)b[26];
+            package[descr.other_channels[3]] = (double)b[27];
+            package[descr.other_channels[4]] = (double)b[28];
+            package[descr.other_channels[5]] = (double)b[29];
+            package[descr.other_channels[6]] = (double)b[30];
+            // place processed bytes for accel
+            if (b[31] == END_BYTE_STANDARD)
+            {
+                int32_t accel_temp[3] = {0};
+                accel_temp[0] = cast_16bit_to_int32 (b + 25);
+                accel_temp[1] = cast_16bit_to_int32 (b + 27);
+                accel_temp[2] = cast_16bit_to_int32 (b + 29);
 
-        if ((b[31] < END_BYTE_STANDARD) || (b[31] > END_BYTE_MAX))
-        {
-            safe_logger (spdlog::level::warn, "Wrong end byte {}", b[31]);
-            continue;
-        }
+                if (accel_temp[0] != 0)
+                {
+                    accel[0] = accel_scale * accel_temp[0];
+                    accel[1] = accel_scale * accel_temp[1];
+                    accel[2] = accel_scale * accel_temp[2];
+                }
 
-        // package num
-        package[board_descr["package_num_channel"].get<int> ()] = (double)b[0];
-        // eeg
-        for (unsigned int i = 0; i < eeg_channels.size (); i++)
-        {
-            package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (b + 1 + 3 * i);
-        }
-        // end byte
-        package[board_descr["other_channels"][0].get<int> ()] = (double)b[31];
-        // place unprocessed bytes for all modes to other_channels
-        package[board_descr["other_channels"][1].get<int> ()] = (double)b[25];
-        package[board_descr["other_channels"][2].get<int> ()] = (double)b[26];
-        package[board_descr["other_channels"][3].get<int> ()] = (double)b[27];
-        package[board_descr["other_channels"][4].get<int> ()] = (double)b[28];
-        package[board_descr["other_channels"][5].get<int> ()] = (double)b[29];
-        package[board_descr["other_channels"][6].get<int> ()] = (double)b[30];
-        // place processed bytes for accel
-        if (b[31] == END_BYTE_STANDARD)
-        {
-            int32_t accel_temp[3] = {0};
-            accel_temp[0] = cast_16bit_to_int32 (b + 25);
-            accel_temp[1] = cast_16bit_to_int32 (b + 27);
-            accel_temp[2] = cast_16bit_to_int32 (b + 29);
+                package[descr.accel_channels[0]] = accel[0];
+                package[descr.accel_channels[1]] = accel[1];
+                package[descr.accel_channels[2]] = accel[2];
+            }
 
-            if (accel_temp[0] != 0)
+            // place processed bytes for analog
+            if (b[31] == END_BYTE_ANALOG)
             {
-                accel[0] = accel_scale * accel_temp[0];
-                accel[1] = accel_scale * accel_temp[1];
-                accel[2] = accel_scale * accel_temp[2];
+                package[descr.analog_channels[0]] = cast_16bit_to_int32 (b + 25);
+                package[descr.analog_channels[1]] = cast_16bit_to_int32 (b + 27);
+                package[descr.analog_channels[2]] = cast_16bit_to_int32 (b + 29);
             }
 
-            package[board_descr["accel_channels"][0].get<int> ()] = accel[0];
-            package[board_descr["accel_channels"][1].get<int> ()] = accel[1];
-            package[board_descr["accel_channels"][2].get<int> ()] = accel[2];
-        }
+            package[descr.timestamp_channel] = get_timestamp ();
 
-        // place processed bytes for analog
-        if (b[31] == END_BYTE_ANALOG)
-        {
-            package[board_descr["analog_channels"][0].get<int> ()] = cast_16bit_to_int32 (b + 25);
-            package[board_descr["analog_channels"][1].get<int> ()] = cast_16bit_to_int32 (b + 27);
-            package[board_descr["analog_channels"][2].get<int> ()] = cast_16bit_to_int32 (b + 29);
+            push_package (package);
         }
-
-        package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
-
-        push_package (package);
     }
     delete[] package;
 }
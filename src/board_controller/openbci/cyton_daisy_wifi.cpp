@@ -41,8 +41,9 @@ void CytonDaisyWifi::read_thread ()
         Byte 33: 0xCX where X is 0-F in hex
     */
     int res;
-    unsigned char b[OpenBCIWifiShieldBoard::package_size];
-    int num_rows = board_descr["num_rows"];
+    unsigned char frames[OpenBCIWifiShieldBoard::package_size *
+        OpenBCIWifiShieldBoard::max_packages_per_recv];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
@@ -54,8 +55,10 @@ void CytonDaisyWifi::read_thread ()
 
     while (keep_alive)
     {
-        res = server_socket->recv (b, OpenBCIWifiShieldBoard::package_size);
-        if (res != OpenBCIWifiShieldBoard::package_size)
+        // all packages received so far
+        res = server_socket->recv_frames (frames, OpenBCIWifiShieldBoard::package_size,
+            OpenBCIWifiShieldBoard::max_packages_per_recv);
+        if (res <= 0)
         {
             if (res < 0)
             {
@@ -69,141 +72,145 @@ void CytonDaisyWifi::read_thread ()
             continue;
         }
 
-        if (b[0] != START_BYTE)
+        for (int frame = 0; frame < res; frame++)
         {
-            continue;
-        }
-        unsigned char *bytes = b + 1; // for better consistency between plain cyton and wifi, in
-                                      // plain cyton index is shifted by 1
-
-        if ((bytes[31] < END_BYTE_STANDARD) || (bytes[31] > END_BYTE_MAX))
-        {
-            safe_logger (spdlog::level::warn, "Wrong end byte {}", bytes[31]);
-            continue;
-        }
-
-
-        // For Cyton Daisy Wifi, sample IDs are repeated twice
-        // (0, 0, 1, 1, 2, 2, 3, 3, ...) so when the sample id
-        // changes, that's how we know it's the first sample
-        if (last_sample_id != bytes[0])
-        {
-            first_sample = true;
-        }
-        last_sample_id = bytes[0];
-
-        // place unprocessed bytes to other_channels for all modes
-        if (first_sample)
-        {
-            package[0] = (double)bytes[0];
-            // eeg
-            for (int i = 0; i < 8; i++)
+            unsigned char *b = frames + frame * OpenBCIWifiShieldBoard::package_size;
+            if (b[0] != START_BYTE)
             {
-                package[i + 1] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
+                continue;
             }
-            // other_channels
-            package[21] = (double)bytes[25];
-            package[22] = (double)bytes[26];
-            package[23] = (double)bytes[27];
-            package[24] = (double)bytes[28];
-            package[25] = (double)bytes[29];
-            package[26] = (double)bytes[30];
-        }
-        else
-        {
-            // eeg
-            for (int i = 0; i < 8; i++)
+            unsigned char *bytes = b + 1; // for better consistency between plain cyton and wifi, in
+                                          // plain cyton index is shifted by 1
+
+            if ((bytes[31] < END_BYTE_STANDARD) || (bytes[31] > END_BYTE_MAX))
             {
-                package[i + 9] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
+                safe_logger (spdlog::level::warn, "Wrong end byte {}", bytes[31]);
+                continue;
             }
-            // need to average other_channels
-            package[21] += (double)bytes[25];
-            package[22] += (double)bytes[28];
-            package[23] += (double)bytes[27];
-            package[24] += (double)bytes[28];
-            package[25] += (double)bytes[29];
-            package[26] += (double)bytes[30];
-            package[21] /= 2.0;
-            package[22] /= 2.0;
-            package[23] /= 2.0;
-            package[24] /= 2.0;
-            package[25] /= 2.0;
-            package[26] /= 2.0;
-            package[20] = (double)bytes[31];
-        }
 
-        // place processed accel data
-        if (bytes[31] == END_BYTE_STANDARD)
-        {
-            int32_t accel_temp[3] = {0};
-            accel_temp[0] = cast_16bit_to_int32 (bytes + 25);
-            accel_temp[1] = cast_16bit_to_int32 (bytes + 27);
-            accel_temp[2] = cast_16bit_to_int32 (bytes + 29);
 
+            // For Cyton Daisy Wifi, sample IDs are repeated twice
+            // (0, 0, 1, 1, 2, 2, 3, 3, ...) so when the sample id
+            // changes, that's how we know it's the first sample
+            if (last_sample_id != bytes[0])
+            {
+                first_sample = true;
+            }
+            last_sample_id = bytes[0];
+
+            // place unprocessed bytes to other_channels for all modes
             if (first_sample)
             {
                 package[0] = (double)bytes[0];
-
-                // accel
-                if (accel_temp[0] != 0)
+                // eeg
+                for (int i = 0; i < 8; i++)
                 {
-                    accel[0] = accel_scale * accel_temp[0];
-                    accel[1] = accel_scale * accel_temp[1];
-                    accel[2] = accel_scale * accel_temp[2];
+                    package[i + 1] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
                 }
+                // other_channels
+                package[21] = (double)bytes[25];
+                package[22] = (double)bytes[26];
+                package[23] = (double)bytes[27];
+                package[24] = (double)bytes[28];
+                package[25] = (double)bytes[29];
+                package[26] = (double)bytes[30];
             }
             else
             {
-                // need to average accel data
-                if (accel_temp[0] != 0)
+                // eeg
+                for (int i = 0; i < 8; i++)
                 {
-                    accel[0] += accel_scale * accel_temp[0];
-                    accel[1] += accel_scale * accel_temp[1];
-                    accel[2] += accel_scale * accel_temp[2];
-
-                    accel[0] /= 2.f;
-                    accel[1] /= 2.f;
-                    accel[2] /= 2.f;
+                    package[i + 9] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
                 }
-
+                // need to average other_channels
+                package[21] += (double)bytes[25];
+                package[22] += (double)bytes[28];
+                package[23] += (double)bytes[27];
+                package[24] += (double)bytes[28];
+                package[25] += (double)bytes[29];
+                package[26] += (double)bytes[30];
+                package[21] /= 2.0;
+                package[22] /= 2.0;
+                package[23] /= 2.0;
+                package[24] /= 2.0;
+                package[25] /= 2.0;
+                package[26] /= 2.0;
                 package[20] = (double)bytes[31];
             }
 
-            package[17] = accel[0];
-            package[18] = accel[1];
-            package[19] = accel[2];
-        }
-        // place processed analog data
-        if (bytes[31] == END_BYTE_ANALOG)
-        {
-            if (first_sample)
+            // place processed accel data
+            if (bytes[31] == END_BYTE_STANDARD)
             {
-                package[0] = (double)bytes[0];
-                // analog
-                package[27] = cast_16bit_to_int32 (bytes + 25);
-                package[28] = cast_16bit_to_int32 (bytes + 27);
-                package[29] = cast_16bit_to_int32 (bytes + 29);
+                int32_t accel_temp[3] = {0};
+                accel_temp[0] = cast_16bit_to_int32 (bytes + 25);
+                accel_temp[1] = cast_16bit_to_int32 (bytes + 27);
+                accel_temp[2] = cast_16bit_to_int32 (bytes + 29);
+
+                if (first_sample)
+                {
+                    package[0] = (double)bytes[0];
+
+                    // accel
+                    if (accel_temp[0] != 0)
+                    {
+                        accel[0] = accel_scale * accel_temp[0];
+                        accel[1] = accel_scale * accel_temp[1];
+                        accel[2] = accel_scale * accel_temp[2];
+                    }
+                }
+                else
+                {
+                    // need to average accel data
+                    if (accel_temp[0] != 0)
+                    {
+                        accel[0] += accel_scale * accel_temp[0];
+                        accel[1] += accel_scale * accel_temp[1];
+                        accel[2] += accel_scale * accel_temp[2];
+
+                        accel[0] /= 2.f;
+                        accel[1] /= 2.f;
+                        accel[2] /= 2.f;
+                    }
+
+                    package[20] = (double)bytes[31];
+                }
+
+                package[17] = accel[0];
+                package[18] = accel[1];
+                package[19] = accel[2];
             }
-            else
+            // place processed analog data
+            if (bytes[31] == END_BYTE_ANALOG)
             {
-                // need to average analog data
-                package[27] += cast_16bit_to_int32 (bytes + 25);
-                package[28] += cast_16bit_to_int32 (bytes + 27);
-                package[29] += cast_16bit_to_int32 (bytes + 29);
-                package[27] /= 2.0f;
-                package[28] /= 2.0f;
-                package[29] /= 2.0f;
-                package[20] = (double)bytes[31]; // cyton end byte
+                if (first_sample)
+                {
+                    package[0] = (double)bytes[0];
+                    // analog
+                    package[27] = cast_16bit_to_int32 (bytes + 25);
+                    package[28] = cast_16bit_to_int32 (bytes + 27);
+                    package[29] = cast_16bit_to_int32 (bytes + 29);
+                }
+                else
+                {
+                    // need to average analog data
+                    package[27] += cast_16bit_to_int32 (bytes + 25);
+                    package[28] += cast_16bit_to_int32 (bytes + 27);
+                    package[29] += cast_16bit_to_int32 (bytes + 29);
+                    package[27] /= 2.0f;
+                    package[28] /= 2.0f;
+                    package[29] /= 2.0f;
+                    package[20] = (double)bytes[31]; // cyton end byte
+                }
+            }
+            // commit package
+            if (!first_sample)
+            {
+                package[descr.timestamp_channel] = server_socket->get_recv_timestamp ();
+                push_package (package);
             }
-        }
-        // commit package
-        if (!first_sample)
-        {
-            package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
-            push_package (package);
-        }
 
-        first_sample = false;
+            first_sample = false;
+        }
     }
     delete[] package;
 }
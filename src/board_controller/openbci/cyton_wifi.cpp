@@ -43,21 +43,23 @@ void CytonWifi::read_thread ()
         Byte 33: 0xCX where X is 0-F in hex
     */
     int res;
-    unsigned char b[OpenBCIWifiShieldBoard::package_size];
+    unsigned char frames[OpenBCIWifiShieldBoard::package_size *
+        OpenBCIWifiShieldBoard::max_packages_per_recv];
     double accel[3] = {0.};
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
         package[i] = 0.0;
     }
-    std::vector<int> eeg_channels = board_descr["eeg_channels"];
+    ChannelList eeg_channels = descr.eeg_channels;
 
     while (keep_alive)
     {
-        // check start byte
-        res = server_socket->recv (b, OpenBCIWifiShieldBoard::package_size);
-        if (res != OpenBCIWifiShieldBoard::package_size)
+        // all packages received so far
+        res = server_socket->recv_frames (frames, OpenBCIWifiShieldBoard::package_size,
+            OpenBCIWifiShieldBoard::max_packages_per_recv);
+        if (res <= 0)
         {
             if (res < 0)
             {
@@ -71,66 +73,67 @@ void CytonWifi::read_thread ()
             continue;
         }
 
-        if (b[0] != START_BYTE)
+        for (int frame = 0; frame < res; frame++)
         {
-            continue;
-        }
-        unsigned char *bytes = b + 1; // for better consistency between plain cyton and wifi, in
-                                      // plain cyton index is shifted by 1
+            unsigned char *b = frames + frame * OpenBCIWifiShieldBoard::package_size;
+            if (b[0] != START_BYTE)
+            {
+                continue;
+            }
+            unsigned char *bytes = b + 1; // for better consistency between plain cyton and wifi, in
+                                          // plain cyton index is shifted by 1
 
-        if ((bytes[31] < END_BYTE_STANDARD) || (bytes[31] > END_BYTE_MAX))
-        {
-            safe_logger (spdlog::level::warn, "Wrong end byte {}", bytes[31]);
-            continue;
-        }
+            if ((bytes[31] < END_BYTE_STANDARD) || (bytes[31] > END_BYTE_MAX))
+            {
+                safe_logger (spdlog::level::warn, "Wrong end byte {}", bytes[31]);
+                continue;
+            }
 
-        // package num
-        package[board_descr["package_num_channel"].get<int> ()] = (double)bytes[0];
-        // eeg
-        for (unsigned int i = 0; i < eeg_channels.size (); i++)
-        {
-            package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
-        }
-        package[board_descr["other_channels"][0].get<int> ()] = (double)bytes[31]; // end byte
-        // place unprocessed bytes for all modes to other_channels
-        package[board_descr["other_channels"][1].get<int> ()] = (double)bytes[25];
-        package[board_descr["other_channels"][2].get<int> ()] = (double)bytes[26];
-        package[board_descr["other_channels"][3].get<int> ()] = (double)bytes[27];
-        package[board_descr["other_channels"][4].get<int> ()] = (double)bytes[28];
-        package[board_descr["other_channels"][5].get<int> ()] = (double)bytes[29];
-        package[board_descr["other_channels"][6].get<int> ()] = (double)bytes[30];
-        // place processed bytes for accel
-        if (bytes[31] == END_BYTE_STANDARD)
-        {
-            int32_t accel_temp[3] = {0};
-            accel_temp[0] = cast_16bit_to_int32 (bytes + 25);
-            accel_temp[1] = cast_16bit_to_int32 (bytes + 27);
-            accel_temp[2] = cast_16bit_to_int32 (bytes + 29);
+            // package num
+            package[descr.package_num_channel] = (double)bytes[0];
+            // eeg
+            for (unsigned int i = 0; i < eeg_channels.size (); i++)
+            {
+                package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
+            }
+            package[descr.other_channels[0]] = (double)bytes[31]; // end byte
+            // place unprocessed bytes for all modes to other_channels
+            package[descr.other_channels[1]] = (double)bytes[25];
+            package[descr.other_channels[2]] = (double)bytes[26];
+            package[descr.other_channels[3]] = (double)bytes[27];
+            package[descr.other_channels[4]] = (double)bytes[28];
+            package[descr.other_channels[5]] = (double)bytes[29];
+            package[descr.other_channels[6]] = (double)bytes[30];
+            // place processed bytes for accel
+            if (bytes[31] == END_BYTE_STANDARD)
+            {
+                int32_t accel_temp[3] = {0};
+                accel_temp[0] = cast_16bit_to_int32 (bytes + 25);
+                accel_temp[1] = cast_16bit_to_int32 (bytes + 27);
+                accel_temp[2] = cast_16bit_to_int32 (bytes + 29);
 
-            if (accel_temp[0] != 0)
+                if (accel_temp[0] != 0)
+                {
+                    accel[0] = accel_scale * accel_temp[0];
+                    accel[1] = accel_scale * accel_temp[1];
+                    accel[2] = accel_scale * accel_temp[2];
+                }
+
+                package[descr.accel_channels[0]] = accel[0];
+                package[descr.accel_channels[1]] = accel[1];
+                package[descr.accel_channels[2]] = accel[2];
+            }
+            // place processed bytes for analog
+            if (bytes[31] == END_BYTE_ANALOG)
             {
-                accel[0] = accel_scale * accel_temp[0];
-                accel[1] = accel_scale * accel_temp[1];
-                accel[2] = accel_scale * accel_temp[2];
+                package[descr.analog_channels[0]] = cast_16bit_to_int32 (bytes + 25);
+                package[descr.analog_channels[1]] = cast_16bit_to_int32 (bytes + 27);
+                package[descr.analog_channels[2]] = cast_16bit_to_int32 (bytes + 29);
             }
 
-            package[board_descr["accel_channels"][0].get<int> ()] = accel[0];
-            package[board_descr["accel_channels"][1].get<int> ()] = accel[1];
-            package[board_descr["accel_channels"][2].get<int> ()] = accel[2];
+            package[descr.timestamp_channel] = server_socket->get_recv_timestamp ();
+            push_package (package);
         }
-        // place processed bytes for analog
-        if (bytes[31] == END_BYTE_ANALOG)
-        {
-            package[board_descr["analog_channels"][0].get<int> ()] =
-                cast_16bit_to_int32 (bytes + 25);
-            package[board_descr["analog_channels"][1].get<int> ()] =
-                cast_16bit_to_int32 (bytes + 27);
-            package[board_descr["analog_channels"][2].get<int> ()] =
-                cast_16bit_to_int32 (bytes + 29);
-        }
-
-        package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
-        push_package (package);
     }
     delete[] package;
 }
@@ -58,6 +58,11 @@ int Galea::prepare_session ()
         socket = NULL;
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
+    // arrival time of datagrams without scheduler delay of read thread
+    if (socket->enable_kernel_timestamps () != (int)SocketClientUDPReturnCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::debug, "kernel timestamps are not supported");
+    }
     // force default settings for device
     std::string tmp;
     std::string default_settings = "d";
@@ -198,6 +203,7 @@ int Galea::start_stream (int buffer_size, char *streamer_params)
         return (int)BrainFlowExitCodes::BOARD_WRITE_ERROR;
     }
 
+    clock_sync.reset ();
     keep_alive = true;
     streaming_thread = std::thread ([this] { this->read_thread (); });
     // wait for data to ensure that everything is okay
@@ -292,13 +298,10 @@ int Galea::release_session ()
 void Galea::read_thread ()
 {
     int res;
-    unsigned char b[Galea::transaction_size];
+    // several transactions are received with one call if reading is delayed
+    DatagramBatch batch (Galea::transaction_size, 16);
     constexpr int offset_last_package = Galea::package_size * (Galea::num_packages - 1);
-    for (int i = 0; i < Galea::transaction_size; i++)
-    {
-        b[i] = 0;
-    }
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
@@ -307,94 +310,128 @@ void Galea::read_thread ()
 
     while (keep_alive)
     {
-        res = socket->recv (b, Galea::transaction_size);
-        double recv_time = get_timestamp () - time_delay;
-        if (res == -1)
+        int num_datagrams = socket->recv_batch (&batch);
+        if (num_datagrams == -1)
         {
 #ifdef _WIN32
             safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
 #else
             safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
 #endif
+            continue;
         }
-        if (res != Galea::transaction_size)
+        // recv_time corresponds to the last package of transaction, without kernel timestamps all
+        // datagrams have the same time and the last transaction in batch is used
+        double recv_time = 0.0;
+        double timestamp_device_last = 0.0;
+        int last_transaction = -1;
+        for (int i = num_datagrams - 1; i >= 0; i--)
         {
-            safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
-                Galea::transaction_size, res);
-            if (res > 0)
+            if (batch.get_size (i) == Galea::transaction_size)
             {
-                // more likely its a string received, try to print it
-                b[res] = '\0';
-                safe_logger (spdlog::level::warn, "Received: {}", b);
+                recv_time = batch.get_timestamp (i) - time_delay;
+                memcpy (&timestamp_device_last, batch.get_datagram (i) + 64 + offset_last_package,
+                    8);
+                timestamp_device_last /= 1e6; // convert usec to sec
+                last_transaction = i;
+                break;
             }
-            continue;
         }
-        else
+
+        for (int cur_datagram = 0; cur_datagram < num_datagrams; cur_datagram++)
         {
-            // inform main thread that everything is ok and first package was received
-            if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
+            unsigned char *b = batch.get_datagram (cur_datagram);
+            res = batch.get_size (cur_datagram);
+            if ((res == Galea::transaction_size) &&
+                ((batch.is_kernel_timestamp (cur_datagram)) || (cur_datagram == last_transaction)))
+            {
+                recv_time = batch.get_timestamp (cur_datagram) - time_delay;
+                memcpy (&timestamp_device_last, b + 64 + offset_last_package, 8);
+                timestamp_device_last /= 1e6;
+                // arrival times of other transactions are unknown without kernel timestamps
+                clock_sync.add (timestamp_device_last, batch.get_timestamp (cur_datagram));
+            }
+            if (res != Galea::transaction_size)
             {
-                safe_logger (spdlog::level::info,
-                    "received first package with {} bytes streaming is started", res);
+                safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
+                    Galea::transaction_size, res);
+                if (res > 0)
                 {
-                    std::lock_guard<std::mutex> lk (this->m);
-                    this->state = (int)BrainFlowExitCodes::STATUS_OK;
+                    // more likely its a string received, try to print it
+                    b[res] = '\0';
+                    safe_logger (spdlog::level::warn, "Received: {}", b);
                 }
-                this->cv.notify_one ();
-                safe_logger (spdlog::level::debug, "start streaming");
+                continue;
             }
-        }
-
-        for (int cur_package = 0; cur_package < Galea::num_packages; cur_package++)
-        {
-            int offset = cur_package * package_size;
-            // package num
-            package[board_descr["package_num_channel"].get<int> ()] = (double)b[0 + offset];
-            // eeg and emg
-            for (int i = 4, tmp_counter = 0; i < 20; i++, tmp_counter++)
+            else
             {
-                // put them directly after package num in brainflow
-                if (tmp_counter < 8)
-                    package[i - 3] = eeg_scale_main_board *
-                        (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-                else if ((tmp_counter == 9) || (tmp_counter == 14))
-                    package[i - 3] = eeg_scale_sister_board *
-                        (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-                else
-                    package[i - 3] =
-                        emg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+                // inform main thread that everything is ok and first package was received
+                if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
+                {
+                    safe_logger (spdlog::level::info,
+                        "received first package with {} bytes streaming is started", res);
+                    {
+                        std::lock_guard<std::mutex> lk (this->m);
+                        this->state = (int)BrainFlowExitCodes::STATUS_OK;
+                    }
+                    this->cv.notify_one ();
+                    safe_logger (spdlog::level::debug, "start streaming");
+                }
             }
-            uint16_t temperature;
-            int32_t ppg_ir;
-            int32_t ppg_red;
-            float eda;
-            memcpy (&temperature, b + 54 + offset, 2);
-            memcpy (&eda, b + 1 + offset, 4);
-            memcpy (&ppg_red, b + 56 + offset, 4);
-            memcpy (&ppg_ir, b + 60 + offset, 4);
-            // ppg
-            package[board_descr["ppg_channels"][0].get<int> ()] = (double)ppg_red;
-            package[board_descr["ppg_channels"][1].get<int> ()] = (double)ppg_ir;
-            // eda
-            package[board_descr["eda_channels"][0].get<int> ()] = (double)eda;
-            // temperature
-            package[board_descr["temperature_channels"][0].get<int> ()] = temperature / 100.0;
-            // battery
-            package[board_descr["battery_channel"].get<int> ()] = (double)b[53 + offset];
 
-            double timestamp_device_cur;
-            memcpy (&timestamp_device_cur, b + 64 + offset, 8);
-            double timestamp_device_last;
-            memcpy (&timestamp_device_last, b + 64 + offset_last_package, 8);
-            timestamp_device_cur /= 1e6; // convert usec to sec
-            timestamp_device_last /= 1e6;
-            double time_delta = timestamp_device_last - timestamp_device_cur;
+            for (int cur_package = 0; cur_package < Galea::num_packages; cur_package++)
+            {
+                int offset = cur_package * package_size;
+                // package num
+                package[descr.package_num_channel] = (double)b[0 + offset];
+                // eeg and emg
+                for (int i = 4, tmp_counter = 0; i < 20; i++, tmp_counter++)
+                {
+                    // put them directly after package num in brainflow
+                    if (tmp_counter < 8)
+                        package[i - 3] = eeg_scale_main_board *
+                            (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+                    else if ((tmp_counter == 9) || (tmp_counter == 14))
+                        package[i - 3] = eeg_scale_sister_board *
+                            (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+                    else
+                        package[i - 3] =
+                            emg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+                }
+                uint16_t temperature;
+                int32_t ppg_ir;
+                int32_t ppg_red;
+                float eda;
+                memcpy (&temperature, b + 54 + offset, 2);
+                memcpy (&eda, b + 1 + offset, 4);
+                memcpy (&ppg_red, b + 56 + offset, 4);
+                memcpy (&ppg_ir, b + 60 + offset, 4);
+                // ppg
+                package[descr.ppg_channels[0]] = (double)ppg_red;
+                package[descr.ppg_channels[1]] = (double)ppg_ir;
+                // eda
+                package[descr.eda_channels[0]] = (double)eda;
+                // temperature
+                package[descr.temperature_channels[0]] = temperature / 100.0;
+                // battery
+                package[descr.battery_channel] = (double)b[53 + offset];
+
+                double timestamp_device_cur;
+                memcpy (&timestamp_device_cur, b + 64 + offset, 8);
+                timestamp_device_cur /= 1e6; // convert usec to sec
+                double time_delta = timestamp_device_last - timestamp_device_cur;
 
-            // workaround micros() overflow issue in firmware
-            double timestamp = (time_delta < 0) ? recv_time : recv_time - time_delta;
-            package[board_descr["timestamp_channel"].get<int> ()] = timestamp;
+                // workaround micros() overflow issue in firmware
+                double timestamp = (time_delta < 0) ? recv_time : recv_time - time_delta;
+                // fitted device clock has no network jitter and follows drift
+                if ((time_delta >= 0) && (clock_sync.is_ready ()))
+                {
+                    timestamp = clock_sync.to_host (timestamp_device_cur) - time_delay;
+                }
+                package[descr.timestamp_channel] = timestamp;
 
-            push_package (package);
+                push_package (package);
+            }
         }
     }
     delete[] package;
@@ -14,7 +14,7 @@
 #include "get_dll_dir.h"
 
 
-int Ganglion::num_objects = 0;
+std::atomic<int> Ganglion::num_objects (0);
 
 
 Ganglion::Ganglion (struct BrainFlowInputParams params)
@@ -243,7 +243,7 @@ void Ganglion::read_thread ()
         return;
     }
 
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
 
     while (keep_alive)
@@ -292,15 +292,15 @@ void Ganglion::read_thread ()
                 last_data[7] = (float)cast_24bit_to_int32 (data.data + 10);
 
                 // scale new packet and insert into result
-                package[board_descr["package_num_channel"].get<int> ()] = 0.;
-                package[board_descr["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[4];
-                package[board_descr["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[5];
-                package[board_descr["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[6];
-                package[board_descr["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[7];
-                package[board_descr["accel_channels"][0].get<int> ()] = accel_x;
-                package[board_descr["accel_channels"][1].get<int> ()] = accel_y;
-                package[board_descr["accel_channels"][2].get<int> ()] = accel_z;
-                package[board_descr["timestamp_channel"].get<int> ()] = data.timestamp;
+                package[descr.package_num_channel] = 0.;
+                package[descr.eeg_channels[0]] = eeg_scale * last_data[4];
+                package[descr.eeg_channels[1]] = eeg_scale * last_data[5];
+                package[descr.eeg_channels[2]] = eeg_scale * last_data[6];
+                package[descr.eeg_channels[3]] = eeg_scale * last_data[7];
+                package[descr.accel_channels[0]] = accel_x;
+                package[descr.accel_channels[1]] = accel_y;
+                package[descr.accel_channels[2]] = accel_z;
+                package[descr.timestamp_channel] = data.timestamp;
                 push_package (package);
                 continue;
             }
@@ -375,13 +375,13 @@ void Ganglion::read_thread ()
                     default:
                         break;
                 }
-                package[board_descr["package_num_channel"].get<int> ()] = data.data[0];
-                package[board_descr["resistance_channels"][0].get<int> ()] = resist_first;
-                package[board_descr["resistance_channels"][1].get<int> ()] = resist_second;
-                package[board_descr["resistance_channels"][2].get<int> ()] = resist_third;
-                package[board_descr["resistance_channels"][3].get<int> ()] = resist_fourth;
-                package[board_descr["resistance_channels"][4].get<int> ()] = resist_ref;
-                package[board_descr["timestamp_channel"].get<int> ()] = data.timestamp;
+                package[descr.package_num_channel] = data.data[0];
+                package[descr.resistance_channels[0]] = resist_first;
+                package[descr.resistance_channels[1]] = resist_second;
+                package[descr.resistance_channels[2]] = resist_third;
+                package[descr.resistance_channels[3]] = resist_fourth;
+                package[descr.resistance_channels[4]] = resist_ref;
+                package[descr.timestamp_channel] = data.timestamp;
                 push_package (package);
                 continue;
             }
@@ -419,22 +419,22 @@ void Ganglion::read_thread ()
             }
 
             // add first encoded package
-            package[board_descr["package_num_channel"].get<int> ()] = data.data[0];
-            package[board_descr["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[0];
-            package[board_descr["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[1];
-            package[board_descr["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[2];
-            package[board_descr["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[3];
-            package[board_descr["accel_channels"][0].get<int> ()] = accel_x;
-            package[board_descr["accel_channels"][1].get<int> ()] = accel_y;
-            package[board_descr["accel_channels"][2].get<int> ()] = accel_z;
-            package[board_descr["timestamp_channel"].get<int> ()] = data.timestamp;
+            package[descr.package_num_channel] = data.data[0];
+            package[descr.eeg_channels[0]] = eeg_scale * last_data[0];
+            package[descr.eeg_channels[1]] = eeg_scale * last_data[1];
+            package[descr.eeg_channels[2]] = eeg_scale * last_data[2];
+            package[descr.eeg_channels[3]] = eeg_scale * last_data[3];
+            package[descr.accel_channels[0]] = accel_x;
+            package[descr.accel_channels[1]] = accel_y;
+            package[descr.accel_channels[2]] = accel_z;
+            package[descr.timestamp_channel] = data.timestamp;
             push_package (package);
             // add second package
-            package[board_descr["eeg_channels"][0].get<int> ()] = eeg_scale * last_data[4];
-            package[board_descr["eeg_channels"][1].get<int> ()] = eeg_scale * last_data[5];
-            package[board_descr["eeg_channels"][2].get<int> ()] = eeg_scale * last_data[6];
-            package[board_descr["eeg_channels"][3].get<int> ()] = eeg_scale * last_data[7];
-            package[board_descr["timestamp_channel"].get<int> ()] = data.timestamp;
+            package[descr.eeg_channels[0]] = eeg_scale * last_data[4];
+            package[descr.eeg_channels[1]] = eeg_scale * last_data[5];
+            package[descr.eeg_channels[2]] = eeg_scale * last_data[6];
+            package[descr.eeg_channels[3]] = eeg_scale * last_data[7];
+            package[descr.timestamp_channel] = data.timestamp;
             push_package (package);
         }
         else
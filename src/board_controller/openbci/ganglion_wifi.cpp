@@ -145,20 +145,22 @@ void GanglionWifi::read_thread ()
         Byte 33: 0xCX where X is 0-F in hex
     */
     int res;
-    unsigned char b[OpenBCIWifiShieldBoard::package_size];
-    int num_rows = board_descr["num_rows"];
+    unsigned char frames[OpenBCIWifiShieldBoard::package_size *
+        OpenBCIWifiShieldBoard::max_packages_per_recv];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
         package[i] = 0.0;
     }
-    std::vector<int> eeg_channels = board_descr["eeg_channels"];
+    ChannelList eeg_channels = descr.eeg_channels;
 
     while (keep_alive)
     {
-        // check start byte
-        res = server_socket->recv (b, OpenBCIWifiShieldBoard::package_size);
-        if (res != OpenBCIWifiShieldBoard::package_size)
+        // all packages received so far
+        res = server_socket->recv_frames (frames, OpenBCIWifiShieldBoard::package_size,
+            OpenBCIWifiShieldBoard::max_packages_per_recv);
+        if (res <= 0)
         {
             if (res < 0)
             {
@@ -172,55 +174,56 @@ void GanglionWifi::read_thread ()
             continue;
         }
 
-        if (b[0] != START_BYTE)
-        {
-            continue;
-        }
-        if ((b[32] < END_BYTE_STANDARD) || (b[32] > END_BYTE_MAX))
+        for (int frame = 0; frame < res; frame++)
         {
-            safe_logger (spdlog::level::warn, "Wrong end byte, found {}", b[32]);
-            continue;
-        }
+            unsigned char *b = frames + frame * OpenBCIWifiShieldBoard::package_size;
+            if (b[0] != START_BYTE)
+            {
+                continue;
+            }
+            if ((b[32] < END_BYTE_STANDARD) || (b[32] > END_BYTE_MAX))
+            {
+                safe_logger (spdlog::level::warn, "Wrong end byte, found {}", b[32]);
+                continue;
+            }
 
-        // package num
-        package[board_descr["package_num_channel"].get<int> ()] = (double)b[1];
-        // eeg
-        for (unsigned int i = 0; i < eeg_channels.size (); i++)
-        {
-            package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (b + 2 + 3 * i);
-        }
-        // end byte
-        package[board_descr["other_channels"][0].get<int> ()] = (double)b[32];
-        // place raw bytes to other_channels with end byte
-        package[board_descr["other_channels"][1].get<int> ()] = (double)b[26];
-        package[board_descr["other_channels"][2].get<int> ()] = (double)b[27];
-        package[board_descr["other_channels"][3].get<int> ()] = (double)b[28];
-        package[board_descr["other_channels"][4].get<int> ()] = (double)b[29];
-        package[board_descr["other_channels"][5].get<int> ()] = (double)b[30];
-        package[board_descr["other_channels"][6].get<int> ()] = (double)b[31];
-        // place accel data
-        if (b[32] == END_BYTE_STANDARD)
-        {
-            // accel
-            // mistake in firmware in axis
-            package[board_descr["accel_channels"][0].get<int> ()] =
-                accel_scale * cast_16bit_to_int32 (b + 28);
-            package[board_descr["accel_channels"][1].get<int> ()] =
-                accel_scale * cast_16bit_to_int32 (b + 26);
-            package[board_descr["accel_channels"][2].get<int> ()] =
-                -accel_scale * cast_16bit_to_int32 (b + 30);
-        }
-        // place analog data
-        if (b[32] == END_BYTE_ANALOG)
-        {
-            // analog
-            package[board_descr["analog_channels"][0].get<int> ()] = cast_16bit_to_int32 (b + 26);
-            package[board_descr["analog_channels"][1].get<int> ()] = cast_16bit_to_int32 (b + 28);
-            package[board_descr["analog_channels"][2].get<int> ()] = cast_16bit_to_int32 (b + 30);
-        }
+            // package num
+            package[descr.package_num_channel] = (double)b[1];
+            // eeg
+            for (unsigned int i = 0; i < eeg_channels.size (); i++)
+            {
+                package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (b + 2 + 3 * i);
+            }
+            // end byte
+            package[descr.other_channels[0]] = (double)b[32];
+            // place raw bytes to other_channels with end byte
+            package[descr.other_channels[1]] = (double)b[26];
+            package[descr.other_channels[2]] = (double)b[27];
+            package[descr.other_channels[3]] = (double)b[28];
+            package[descr.other_channels[4]] = (double)b[29];
+            package[descr.other_channels[5]] = (double)b[30];
+            package[descr.other_channels[6]] = (double)b[31];
+            // place accel data
+            if (b[32] == END_BYTE_STANDARD)
+            {
+                // accel
+                // mistake in firmware in axis
+                package[descr.accel_channels[0]] = accel_scale * cast_16bit_to_int32 (b + 28);
+                package[descr.accel_channels[1]] = accel_scale * cast_16bit_to_int32 (b + 26);
+                package[descr.accel_channels[2]] = -accel_scale * cast_16bit_to_int32 (b + 30);
+            }
+            // place analog data
+            if (b[32] == END_BYTE_ANALOG)
+            {
+                // analog
+                package[descr.analog_channels[0]] = cast_16bit_to_int32 (b + 26);
+                package[descr.analog_channels[1]] = cast_16bit_to_int32 (b + 28);
+                package[descr.analog_channels[2]] = cast_16bit_to_int32 (b + 30);
+            }
 
-        package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
-        push_package (package);
+            package[descr.timestamp_channel] = server_socket->get_recv_timestamp ();
+            push_package (package);
+        }
     }
     delete[] package;
 }
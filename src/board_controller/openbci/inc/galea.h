@@ -7,6 +7,7 @@
 
 #include "board.h"
 #include "board_controller.h"
+#include "clock_sync.h"
 #include "socket_client_udp.h"
 
 #define ADS1299_Vref 4.5
@@ -32,6 +33,8 @@ private:
     std::condition_variable cv;
     volatile int state;
     volatile double time_delay;
+    // maps device timestamps to host time, used only in read thread
+    ClockSync clock_sync;
     void read_thread ();
     int calc_delay ();
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string>
@@ -15,7 +16,8 @@ class Ganglion : public Board
 {
 
 private:
-    static int num_objects;
+    // constructed under registry lock but destroyed without it
+    static std::atomic<int> num_objects;
 
     bool is_valid;
 
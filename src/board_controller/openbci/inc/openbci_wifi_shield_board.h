@@ -39,4 +39,5 @@ public:
     virtual int config_board (std::string config, std::string &response);
 
     static constexpr int package_size = 33;
+    static constexpr int max_packages_per_recv = 64;
 };
@@ -77,6 +77,10 @@ int OpenBCIWifiShieldBoard::prepare_session ()
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
     safe_logger (spdlog::level::trace, "bind socket, port  is {}", params.ip_port);
+    if (server_socket->enable_kernel_timestamps () != (int)SocketServerTCPReturnCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::debug, "kernel timestamps are not supported");
+    }
 
     // run accept in another thread to dont block
     res = server_socket->accept ();
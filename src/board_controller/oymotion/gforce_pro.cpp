@@ -13,7 +13,7 @@
 
 #include "gforce_wrapper_types.h"
 
-int GforcePro::num_objects = 0;
+std::atomic<int> GforcePro::num_objects (0);
 
 
 GforcePro::GforcePro (struct BrainFlowInputParams params)
@@ -1,5 +1,6 @@
+#include <algorithm>
 #include <chrono>
-#include <sstream>
+#include <map>
 #include <stdio.h>
 #include <string.h>
 #include <string>
@@ -10,13 +11,19 @@
 #include <unistd.h>
 #endif
 
+#include "binary_file.h"
+#include "csv_reader.h"
+#include "brainflow_boards.h"
+#include "custom_cast.h"
 #include "playback_file_board.h"
-#include "timestamp.h"
 
 #define SET_LOOPBACK_TRUE "loopback_true"
 #define SET_LOOPBACK_FALSE "loopback_false"
 #define NEW_TIMESTAMPS "new_timestamps"
 #define OLD_TIMESTAMPS "old_timestamps"
+#define SET_SPEED "set_speed:"           // multiplier, 0 is as fast as possible
+#define SEEK_SAMPLE "seek_sample:"       // index of sample in file
+#define SEEK_TIMESTAMP "seek_timestamp:" // timestamp in file
 
 
 PlaybackFileBoard::PlaybackFileBoard (struct BrainFlowInputParams params)
@@ -30,6 +37,20 @@ PlaybackFileBoard::PlaybackFileBoard (struct BrainFlowInputParams params)
     is_streaming = false;
     initialized = false;
     use_new_timestamps = true;
+    is_binary = false;
+    batch_size = 1;
+    new_timestamps = true;
+    file_base = -1.0;
+    offset_base = 0;
+    last_offset = 0;
+    batch_len = 0;
+    num_rows = 0;
+    csv_offset = 0;
+    cur_block = (size_t)-1;
+    speed = 1.0;
+    seek_pending = false;
+    seek_by_timestamp = false;
+    seek_value = 0.0;
     this->state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
 }
 
@@ -51,16 +72,10 @@ int PlaybackFileBoard::prepare_session ()
         safe_logger (spdlog::level::err, "playback file or master board id not provided");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    try
-    {
-        board_id = std::stoi (params.other_info);
-    }
-    catch (const std::exception &e)
+    int res = parse_options ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        safe_logger (
-            spdlog::level::err, "Write board id of board which recorded data to other_info field");
-        safe_logger (spdlog::level::err, e.what ());
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        return res;
     }
     // check that file exist in prepare_session
     FILE *fp;
@@ -72,6 +87,35 @@ int PlaybackFileBoard::prepare_session ()
     }
     fclose (fp);
 
+    try
+    {
+        num_rows = brainflow_boards_json["boards"][int_to_string (board_id)]["num_rows"];
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    // file is loaded once here, start_stream waits only for the first package and loopback,
+    // seek and next streams dont read it again
+    samples.clear ();
+    csv_offset = 0;
+    is_binary = BinaryFileReader::is_binary_file (params.file.c_str ());
+    if (is_binary)
+    {
+        res = load_binary_file ();
+    }
+    else if (load_csv_rows () < 0)
+    {
+        res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        binary_reader.close_file ();
+        return res;
+    }
+
     initialized = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -133,42 +177,99 @@ int PlaybackFileBoard::release_session ()
     {
         stop_stream ();
         free_packages ();
+        binary_reader.close_file ();
+        samples.clear ();
+        samples.shrink_to_fit ();
+        block_starts.clear ();
+        cur_block = (size_t)-1;
         initialized = false;
     }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void PlaybackFileBoard::read_thread ()
+int PlaybackFileBoard::parse_options ()
 {
-    FILE *fp;
-    fp = fopen (params.file.c_str (), "r");
-    if (fp == NULL)
+    size_t options_idx = params.other_info.find ("&");
+    try
     {
-        safe_logger (spdlog::level::err, "failed to open file in thread");
-        return;
+        board_id = std::stoi (params.other_info.substr (0, options_idx));
     }
-    int num_rows = board_descr["num_rows"];
-    double *package = new double[num_rows];
-    for (int i = 0; i < num_rows; i++)
+    catch (const std::exception &e)
     {
-        package[i] = 0.0;
+        safe_logger (
+            spdlog::level::err, "Write board id of board which recorded data to other_info field");
+        safe_logger (spdlog::level::err, e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    char buf[4096];
-    double last_timestamp = -1.0;
-    bool new_timestamps = use_new_timestamps; // to prevent changing during streaming
-    int timestamp_channel = board_descr["timestamp_channel"];
+    if (options_idx == std::string::npos)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    std::map<std::string, std::string> options;
+    parse_board_options (params.other_info.substr (options_idx + 1), &options);
+    int batch = 1;
+    int res = pop_int_option (options, "batch_size", &batch);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    for (auto &option : options)
+    {
+        safe_logger (spdlog::level::warn, "option {} in other_info is ignored", option.first);
+    }
+    if (batch < 1)
+    {
+        safe_logger (spdlog::level::err, "batch_size should be positive");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    batch_size = batch;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void PlaybackFileBoard::read_thread ()
+{
+    new_timestamps = use_new_timestamps; // to prevent changing during streaming
+    file_base = -1.0;
+    offset_base = 0;
+    last_offset = 0;
+    batch.assign ((size_t)descr.num_rows * batch_size, 0.0);
+    batch_len = 0;
+    clock.start ();
 
+    size_t pos = 0;
+    double current_speed = speed;
     while (keep_alive)
     {
-        char *res = fgets (buf, sizeof (buf), fp);
-        if ((loopback) && (res == NULL))
+        if (seek_pending)
         {
-            fseek (fp, 0, SEEK_SET); // go to beginning'
-            last_timestamp = -1.0;
-            continue;
+            pos = get_seek_pos ();
+            restart_timeline (0);
+        }
+        if (speed != current_speed)
+        {
+            current_speed = speed;
+            restart_timeline (0);
         }
-        if ((!loopback) && (res == NULL))
+        if (pos >= get_num_samples ())
         {
+            // empty file goes to the sleep below even with loopback
+            if ((loopback) && (get_num_samples () > 0))
+            {
+                pos = 0;
+                int64_t gap = 0;
+                if ((descr.sampling_rate > 0) && (current_speed > 0))
+                {
+                    gap = (int64_t)(1e9 / descr.sampling_rate / current_speed);
+                }
+                restart_timeline (gap);
+                continue;
+            }
+            // csv file may be still written
+            if ((!is_binary) && (load_csv_rows () > 0))
+            {
+                continue;
+            }
+            flush_batch ();
 // busy wait instead exit
 #ifdef _WIN32
             Sleep (1);
@@ -177,54 +278,232 @@ void PlaybackFileBoard::read_thread ()
 #endif
             continue;
         }
-        // res not NULL
-        std::string csv_string (buf);
-        std::stringstream ss (csv_string);
-        std::vector<std::string> splitted;
-        std::string tmp;
-        while (getline (ss, tmp, ','))
+        const double *package = get_sample (pos);
+        if (package == NULL)
         {
-            splitted.push_back (tmp);
-        }
-        if (splitted.size () != num_rows)
-        {
-            safe_logger (spdlog::level::err,
-                "invalid string in file, check provided board id. String size {}, expected size {}",
-                splitted.size (), num_rows);
+            // broken block, skip it
+            pos = (size_t)block_starts[cur_block + 1];
             continue;
         }
-        for (int i = 0; i < num_rows; i++)
+        push_with_delay (package, current_speed);
+        pos++;
+    }
+}
+
+// appends complete rows written after csv_offset to samples, returns number of new rows or -1
+int64_t PlaybackFileBoard::load_csv_rows ()
+{
+    CSVReader reader;
+    if (reader.open_file (params.file.c_str (), csv_offset, true) !=
+        (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "failed to open file {}", params.file);
+        return -1;
+    }
+    reader.set_num_cols (num_rows);
+    int64_t num_lines = reader.count_rows ();
+    if (num_lines == 0)
+    {
+        return 0;
+    }
+    size_t old_size = samples.size ();
+    samples.resize (old_size + (size_t)num_lines * num_rows);
+    int64_t num_new = reader.read_rows (&samples[old_size], num_lines, false);
+    samples.resize (old_size + (size_t)num_new * num_rows);
+    csv_offset = reader.get_end_offset ();
+    if (reader.get_num_skipped () > 0)
+    {
+        safe_logger (spdlog::level::err,
+            "{} invalid rows in file, check provided board id. Expected size {}",
+            reader.get_num_skipped (), num_rows);
+    }
+    return num_new;
+}
+
+// only header and block index are read here, blocks are read by read thread when needed
+int PlaybackFileBoard::load_binary_file ()
+{
+    if (binary_reader.open_file (params.file.c_str ()) != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "invalid binary file");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    const struct BinaryFileHeader &header = binary_reader.get_header ();
+    if ((header.board_id >= 0) && (header.board_id != board_id))
+    {
+        safe_logger (spdlog::level::warn, "file was recorded by board {}, provided board id is {}",
+            header.board_id, board_id);
+    }
+    if (num_rows != header.num_rows)
+    {
+        safe_logger (spdlog::level::err,
+            "file has {} rows, board {} has {} rows, check provided board id", header.num_rows,
+            board_id, num_rows);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    block_starts.assign (1, 0);
+    for (size_t i = 0; i < binary_reader.get_num_blocks (); i++)
+    {
+        block_starts.push_back (block_starts.back () + binary_reader.get_block_len (i));
+    }
+    block_buf.assign ((size_t)num_rows * header.block_size, 0.0);
+    block_samples.assign ((size_t)num_rows * header.block_size, 0.0);
+    cur_block = (size_t)-1;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+size_t PlaybackFileBoard::get_num_samples () const
+{
+    if (is_binary)
+    {
+        return (size_t)block_starts.back ();
+    }
+    return samples.size () / num_rows;
+}
+
+// row-major sample at pos < get_num_samples (), for binary file block with this sample becomes
+// the current one, returns NULL if block cant be read
+const double *PlaybackFileBoard::get_sample (size_t pos)
+{
+    if (!is_binary)
+    {
+        return &samples[pos * num_rows];
+    }
+    auto next_block = std::upper_bound (block_starts.begin (), block_starts.end (), (int64_t)pos);
+    size_t block = (size_t)(next_block - block_starts.begin ()) - 1;
+    if (block != cur_block)
+    {
+        cur_block = block;
+        int block_size = binary_reader.get_header ().block_size;
+        int block_len = binary_reader.read_block (block, block_buf.data ());
+        if (block_len < 0)
         {
-            package[i] = std::stod (splitted[i]);
+            safe_logger (spdlog::level::err, "failed to read block {}", block);
+            return NULL;
         }
-        // notify main thread
-        if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
+        for (int sample = 0; sample < block_len; sample++)
         {
+            for (int channel = 0; channel < num_rows; channel++)
             {
-                std::lock_guard<std::mutex> lk (this->m);
-                this->state = (int)BrainFlowExitCodes::STATUS_OK;
+                block_samples[(size_t)sample * num_rows + channel] =
+                    block_buf[(size_t)channel * block_size + sample];
             }
-            this->cv.notify_one ();
         }
-        if (last_timestamp > 0)
+    }
+    return &block_samples[(pos - (size_t)block_starts[block]) * num_rows];
+}
+
+// first sample with timestamp >= requested one or sample with requested index, samples are
+// expected to be sorted by timestamp
+size_t PlaybackFileBoard::get_seek_pos ()
+{
+    std::lock_guard<std::mutex> lk (this->m);
+    seek_pending = false;
+    size_t num_samples = get_num_samples ();
+    if (!seek_by_timestamp)
+    {
+        size_t pos = (size_t)seek_value;
+        if (pos > num_samples)
         {
-            double time_wait = package[timestamp_channel] - last_timestamp; // in seconds
-#ifdef _WIN32
-            Sleep ((int)(time_wait * 1000 + 0.5));
-#else
-            usleep ((int)(time_wait * 1000000 + 0.5));
-#endif
+            safe_logger (
+                spdlog::level::warn, "seek to {} but file has {} samples", pos, num_samples);
+            pos = num_samples;
         }
-        last_timestamp = package[timestamp_channel];
+        return pos;
+    }
+    // binary file reads only blocks touched by search
+    int timestamp_channel = descr.timestamp_channel;
+    size_t first = 0;
+    size_t last = num_samples;
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+        const double *sample = get_sample (middle);
+        if ((sample == NULL) || (sample[timestamp_channel] < seek_value))
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+// next package starts new timeline gap_ns after the last one or now if playback is late
+void PlaybackFileBoard::restart_timeline (int64_t gap_ns)
+{
+    file_base = -1.0;
+    offset_base = clock.get_elapsed_ns ();
+    if (offset_base < last_offset + gap_ns)
+    {
+        offset_base = last_offset + gap_ns;
+    }
+}
 
-        if (new_timestamps)
+// keeps original intervals between packages divided by speed: deadline of each package is its
+// timestamp in file relative to the first one, new timestamps are interpolated from the same
+// offsets, speed 0 pushes packages without waiting and stamps them with current time
+void PlaybackFileBoard::push_with_delay (const double *package, double current_speed)
+{
+    int timestamp_channel = descr.timestamp_channel;
+    // notify main thread
+    if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
+    {
         {
-            package[timestamp_channel] = get_timestamp ();
+            std::lock_guard<std::mutex> lk (this->m);
+            this->state = (int)BrainFlowExitCodes::STATUS_OK;
         }
-        push_package (package);
+        this->cv.notify_one ();
+    }
+    int64_t offset = 0;
+    if (current_speed > 0)
+    {
+        if (file_base < 0)
+        {
+            file_base = package[timestamp_channel];
+        }
+        offset = offset_base +
+            (int64_t)((package[timestamp_channel] - file_base) * 1e9 / current_speed);
+    }
+    else
+    {
+        offset = clock.get_elapsed_ns ();
+    }
+    // timeline never goes back even if timestamps in file do
+    if (offset < last_offset)
+    {
+        offset = last_offset;
+    }
+    last_offset = offset;
+
+    double *batch_package = &batch[(size_t)batch_len * num_rows];
+    memcpy (batch_package, package, sizeof (double) * num_rows);
+    if (new_timestamps)
+    {
+        batch_package[timestamp_channel] = clock.get_timestamp (offset);
+    }
+    batch_len++;
+    if (batch_len == batch_size)
+    {
+        flush_batch ();
     }
-    fclose (fp);
-    delete[] package;
+}
+
+// waits once for the last package in batch instead of sleeping before each one
+void PlaybackFileBoard::flush_batch ()
+{
+    if (batch_len == 0)
+    {
+        return;
+    }
+    clock.sleep_until (last_offset);
+    for (int i = 0; i < batch_len; i++)
+    {
+        push_package (&batch[(size_t)i * descr.num_rows]);
+    }
+    batch_len = 0;
 }
 
 int PlaybackFileBoard::config_board (std::string config, std::string &response)
@@ -245,6 +524,37 @@ int PlaybackFileBoard::config_board (std::string config, std::string &response)
     {
         use_new_timestamps = false;
     }
+    else if ((config.find (SET_SPEED) == 0) || (config.find (SEEK_SAMPLE) == 0) ||
+        (config.find (SEEK_TIMESTAMP) == 0))
+    {
+        size_t idx = config.find (":");
+        double value = 0.0;
+        try
+        {
+            value = std::stod (config.substr (idx + 1));
+        }
+        catch (const std::exception &e)
+        {
+            safe_logger (spdlog::level::err, "invalid value in {}: {}", config, e.what ());
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if ((value < 0) && (config.find (SEEK_TIMESTAMP) != 0))
+        {
+            safe_logger (spdlog::level::err, "value in {} should not be negative", config);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if (config.find (SET_SPEED) == 0)
+        {
+            speed = value;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lk (this->m);
+            seek_by_timestamp = (config.find (SEEK_TIMESTAMP) == 0);
+            seek_value = value;
+            seek_pending = true;
+        }
+    }
     else
     {
         safe_logger (spdlog::level::warn, "invalid config string {}", config);
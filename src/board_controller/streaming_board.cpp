@@ -1,6 +1,8 @@
 #include <string.h>
 
 #include "board_info_getter.h"
+#include "multicast_frame.h"
+#include "sample_format.h"
 #include "streaming_board.h"
 
 #ifndef _WIN32
@@ -127,27 +129,96 @@ int StreamingBoard::release_session ()
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// accepts frames with several packages and old datagrams with one package without header
 void StreamingBoard::read_thread ()
 {
     // format for incomming package is determined by original board
-    int num_rows = board_descr["num_rows"];
-    int bytes_per_recv = sizeof (double) * num_rows;
+    int num_rows = descr.num_rows;
+    int bytes_per_package = sizeof (double) * num_rows;
+    int header_size = (int)sizeof (struct MultiCastFrameHeader);
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
         package[i] = 0.0;
     }
+    bool has_seq = false;
+    uint64_t expected_seq = 0;
+    uint64_t num_lost = 0;
+    // float32 frames are unpacked by layout for timestamp channel from the last frame
+    SampleLayout float_layout (num_rows, 1, SampleFormat::FLOAT32, descr.timestamp_channel);
+    int float_timestamp_channel = descr.timestamp_channel;
+
+    // frames are up to mtu size usually, but legacy streamers may send bigger datagrams
+    DatagramBatch batch (MULTICAST_MAX_DATAGRAM_SIZE, 16);
 
     while (keep_alive)
     {
-        int res = client->recv (package, bytes_per_recv);
-        if (res != bytes_per_recv)
+        int num_datagrams = client->recv_batch (&batch);
+        for (int d = 0; d < num_datagrams; d++)
         {
-            safe_logger (
-                spdlog::level::trace, "unable to read {} bytes, read {}", bytes_per_recv, res);
-            continue;
+            const char *datagram = (const char *)batch.get_datagram (d);
+            int res = batch.get_size (d);
+            struct MultiCastFrameHeader header;
+            memset (&header, 0, sizeof (header));
+            if (res >= header_size)
+            {
+                memcpy (&header, datagram, sizeof (header));
+            }
+            // float32 frame with one package may have the same size as legacy datagram, so size
+            // is used only for datagrams without frame magic and version
+            bool has_magic = (res >= header_size) && (header.magic == MULTICAST_FRAME_MAGIC) &&
+                (header.version == MULTICAST_FRAME_VERSION);
+            if ((!has_magic) && (res == bytes_per_package))
+            {
+                memcpy (package, datagram, bytes_per_package);
+                push_package (package);
+                continue;
+            }
+            bool is_float = (header.sample_format == (uint8_t)SampleFormat::FLOAT32);
+            if ((is_float) && (header.timestamp_channel != float_timestamp_channel))
+            {
+                float_timestamp_channel = header.timestamp_channel;
+                float_layout =
+                    SampleLayout (num_rows, 1, SampleFormat::FLOAT32, float_timestamp_channel);
+            }
+            int frame_package_size = is_float ? (int)float_layout.get_size () : bytes_per_package;
+            if ((res < header_size) || (header.magic != MULTICAST_FRAME_MAGIC) ||
+                (header.version != MULTICAST_FRAME_VERSION) || (header.num_rows != num_rows) ||
+                (header.board_id != board_id) ||
+                ((!is_float) && (header.sample_format != (uint8_t)SampleFormat::FLOAT64)) ||
+                (res != header_size + header.num_samples * frame_package_size))
+            {
+                safe_logger (spdlog::level::trace,
+                    "unable to parse datagram of {} bytes, expected frame or {} bytes", res,
+                    bytes_per_package);
+                continue;
+            }
+            if ((has_seq) && (header.seq > expected_seq))
+            {
+                num_lost += header.seq - expected_seq;
+                safe_logger (spdlog::level::warn, "lost {} packages, total lost {}",
+                    header.seq - expected_seq, num_lost);
+            }
+            else if ((has_seq) && (header.seq < expected_seq))
+            {
+                safe_logger (spdlog::level::info, "sequence number was reset by streamer");
+            }
+            has_seq = true;
+            expected_seq = header.seq + header.num_samples;
+            for (int i = 0; i < header.num_samples; i++)
+            {
+                const char *frame_package = datagram + header_size + i * frame_package_size;
+                if (is_float)
+                {
+                    float_layout.read (frame_package, 0, 1, package, 1);
+                }
+                else
+                {
+                    memcpy (package, frame_package, bytes_per_package);
+                }
+                push_package (package);
+            }
         }
-        push_package (package);
     }
     delete[] package;
 }
@@ -1,19 +1,14 @@
 #include <chrono>
-#include <fstream>
+#include <map>
 #include <math.h>
-#include <random>
+#include <stdint.h>
 #include <string.h>
 #include <string>
 #include <vector>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#endif
-
+#include "custom_cast.h"
+#include "sample_clock.h"
 #include "synthetic_board.h"
-#include "timestamp.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -26,6 +21,14 @@ SyntheticBoard::SyntheticBoard (struct BrainFlowInputParams params)
     is_streaming = false;
     keep_alive = false;
     initialized = false;
+    sampling_rate = 0; // 0 means value from brainflow_boards
+    num_channels = 0;
+    batch_size = 1;
+    unthrottled = false;
+    for (int i = 0; i < SYNTHETIC_TABLE_SIZE; i++)
+    {
+        sin_table[i] = sin (2.0 * M_PI * i / SYNTHETIC_TABLE_SIZE);
+    }
 }
 
 SyntheticBoard::~SyntheticBoard ()
@@ -43,6 +46,11 @@ int SyntheticBoard::prepare_session ()
         return (int)BrainFlowExitCodes::STATUS_OK;
     }
 
+    int res = parse_options ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
     initialized = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -95,102 +103,199 @@ int SyntheticBoard::release_session ()
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int SyntheticBoard::parse_options ()
+{
+    std::map<std::string, std::string> options;
+    parse_board_options (params.other_info, &options);
+    int rate = 0;
+    int channels = 0;
+    int batch = 1;
+    int no_sleep = 0;
+    int res = pop_int_option (options, "sampling_rate", &rate);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = pop_int_option (options, "num_channels", &channels);
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = pop_int_option (options, "batch_size", &batch);
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = pop_int_option (options, "unthrottled", &no_sleep);
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    for (auto &option : options)
+    {
+        safe_logger (spdlog::level::warn, "option {} in other_info is ignored", option.first);
+    }
+    // rows are fixed by get_num_rows, so only existing exg rows can be filled
+    int max_channels = 0;
+    try
+    {
+        json board_json = brainflow_boards_json["boards"][int_to_string (board_id)];
+        max_channels = (int)board_json["eeg_channels"].size ();
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, e.what ());
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    if ((rate < 0) || (channels < 0) || (channels > max_channels) || (batch < 1))
+    {
+        safe_logger (spdlog::level::err,
+            "invalid other_info, sampling_rate {}, num_channels {}(max {}), batch_size {}", rate,
+            channels, max_channels, batch);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (rate > 0)
+    {
+        safe_logger (spdlog::level::warn,
+            "sampling rate is {}, get_sampling_rate reports default value, use "
+            "config_board (\"get_sampling_rate\") to get the rate of this session",
+            rate);
+    }
+    sampling_rate = rate;
+    num_channels = channels;
+    batch_size = batch;
+    unthrottled = (no_sleep != 0);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// markers and recorded files use rate from descr
+void SyntheticBoard::update_descr ()
+{
+    if (sampling_rate > 0)
+    {
+        descr.sampling_rate = sampling_rate;
+    }
+}
+
 void SyntheticBoard::read_thread ()
 {
     unsigned char counter = 0;
-    std::vector<int> exg_channels = board_descr["eeg_channels"]; // same channels for eeg\emg\ecg
-    double *sin_phase_rad = new double[exg_channels.size ()];
-    for (unsigned int i = 0; i < board_descr["eeg_channels"].size (); i++)
+    ChannelList exg_channels = descr.eeg_channels; // same channels for eeg\emg\ecg
+    // unused exg rows stay zero
+    int num_exg = (num_channels > 0) ? num_channels : (int)exg_channels.size ();
+    int rate = descr.sampling_rate;
+    // phase is a fraction of period scaled to 2^32, highest bits are index in sin_table
+    const int table_shift = 32 - (int)log2 ((double)SYNTHETIC_TABLE_SIZE);
+    std::vector<uint32_t> phase (num_exg);
+    std::vector<uint32_t> phase_step (num_exg);
+    std::vector<double> amplitude (num_exg);
+    std::vector<double> noise_range (num_exg);
+    for (int i = 0; i < num_exg; i++)
     {
-        sin_phase_rad[i] = 0.0;
+        double freq = 5.0 * (i + 1);
+        double shift = 0.05 * i;
+        amplitude[i] = 10.0 * (i + 1);
+        noise_range[i] = amplitude[i] * 0.1 * (i + 1);
+        phase[i] = (uint32_t)(shift / (2.0 * M_PI) * 4294967296.0);
+        phase_step[i] = (uint32_t)(fmod (freq / rate, 1.0) * 4294967296.0);
     }
-    int sampling_rate = board_descr["sampling_rate"];
-    int initial_sleep_time = 1000 / sampling_rate;
-    int sleep_time = initial_sleep_time;
-    std::uniform_real_distribution<double> dist_around_one (0.90, 1.10);
-    uint64_t seed = std::chrono::high_resolution_clock::now ().time_since_epoch ().count ();
-    std::mt19937 mt (static_cast<uint32_t> (seed));
-    double accumulated_time_delta = 0.0;
+    // lcg instead of std::mt19937 and distributions, returns value in [-0.5, 0.5)
+    uint32_t noise_state =
+        (uint32_t)std::chrono::high_resolution_clock::now ().time_since_epoch ().count ();
+    auto noise = [&noise_state] () {
+        noise_state = noise_state * 1664525u + 1013904223u;
+        return (noise_state >> 8) / 16777216.0 - 0.5;
+    };
 
-    int num_rows = board_descr["num_rows"];
+    int num_rows = descr.num_rows;
     double *package = new double[num_rows];
     for (int i = 0; i < num_rows; i++)
     {
         package[i] = 0.0;
     }
 
+    // sample n belongs to offset n / rate from start, batch is pushed once its last sample is due,
+    // unthrottled mode spreads timestamps of batch between previous and current clock readings
+    SampleClock clock;
+    clock.start ();
+    double sample_interval_ns = 1e9 / rate;
+    int64_t num_samples = 0;
+    int64_t batch_start_ns = 0;
     while (keep_alive)
     {
-        auto start = std::chrono::high_resolution_clock::now ();
-        package[board_descr["package_num_channel"].get<int> ()] = (double)counter;
-        for (unsigned int i = 0; i < exg_channels.size (); i++)
+        int64_t batch_end_ns = 0;
+        if (unthrottled)
         {
-            double amplitude = 10.0 * (i + 1);
-            double noise = 0.1 * (i + 1);
-            double freq = 5.0 * (i + 1);
-            double shift = 0.05 * i;
-            double range = (amplitude * noise) / 2.0;
-            std::uniform_real_distribution<double> dist (0 - range, range);
-            sin_phase_rad[i] += 2.0f * M_PI * freq / (double)sampling_rate;
-            if (sin_phase_rad[i] > 2.0f * M_PI)
-            {
-                sin_phase_rad[i] -= 2.0f * M_PI;
-            }
-            package[exg_channels[i]] =
-                (amplitude + dist (mt)) * sqrt (2.0) * sin (sin_phase_rad[i] + shift);
-        }
-        for (int channel : board_descr["accel_channels"])
-        {
-            package[channel] = dist_around_one (mt) - 0.1;
-        }
-        for (int channel : board_descr["gyro_channels"])
-        {
-            package[channel] = dist_around_one (mt) - 0.1;
-        }
-        for (int channel : board_descr["eda_channels"])
-        {
-            package[channel] = dist_around_one (mt);
-        }
-        for (int channel : board_descr["ppg_channels"])
-        {
-            package[channel] = 5000.0 * dist_around_one (mt);
+            batch_end_ns = clock.get_elapsed_ns ();
         }
-        for (int channel : board_descr["temperature_channels"])
+        else
         {
-            package[channel] = dist_around_one (mt) / 10.0 + 36.5;
+            batch_end_ns = (int64_t)((num_samples + batch_size - 1) * sample_interval_ns);
+            clock.sleep_until (batch_end_ns);
         }
-        for (int channel : board_descr["resistance_channels"])
+        for (int sample = 0; sample < batch_size; sample++)
         {
-            package[channel] = 1000.0 * dist_around_one (mt);
-        }
-        package[board_descr["battery_channel"].get<int> ()] = (dist_around_one (mt) - 0.1) * 100;
-        package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
-
-        push_package (package); // use this method to submit data to buffers
+            package[descr.package_num_channel] = (double)counter;
+            for (int i = 0; i < num_exg; i++)
+            {
+                phase[i] += phase_step[i];
+                package[exg_channels[i]] = (amplitude[i] + noise_range[i] * noise ()) *
+                    sqrt (2.0) * sin_table[phase[i] >> table_shift];
+            }
+            for (int channel : descr.accel_channels)
+            {
+                package[channel] = 0.9 + 0.2 * noise ();
+            }
+            for (int channel : descr.gyro_channels)
+            {
+                package[channel] = 0.9 + 0.2 * noise ();
+            }
+            for (int channel : descr.eda_channels)
+            {
+                package[channel] = 1.0 + 0.2 * noise ();
+            }
+            for (int channel : descr.ppg_channels)
+            {
+                package[channel] = 5000.0 * (1.0 + 0.2 * noise ());
+            }
+            for (int channel : descr.temperature_channels)
+            {
+                package[channel] = (1.0 + 0.2 * noise ()) / 10.0 + 36.5;
+            }
+            for (int channel : descr.resistance_channels)
+            {
+                package[channel] = 1000.0 * (1.0 + 0.2 * noise ());
+            }
+            package[descr.battery_channel] = (0.9 + 0.2 * noise ()) * 100;
+            int64_t offset_ns = unthrottled ?
+                batch_start_ns + (batch_end_ns - batch_start_ns) * (sample + 1) / batch_size :
+                (int64_t)(num_samples * sample_interval_ns);
+            package[descr.timestamp_channel] = clock.get_timestamp (offset_ns);
 
-        counter++;
-        if (sleep_time > 0)
-        {
-#ifdef _WIN32
-            Sleep (sleep_time);
-#else
-            usleep (sleep_time * 1000);
-#endif
+            push_package (package); // use this method to submit data to buffers
+            counter++;
+            num_samples++;
         }
-
-        auto stop = std::chrono::high_resolution_clock::now ();
-        auto duration =
-            std::chrono::duration_cast<std::chrono::microseconds> (stop - start).count ();
-        accumulated_time_delta += duration - initial_sleep_time * 1000;
-        sleep_time = initial_sleep_time - (int)(accumulated_time_delta / 1000.0);
-        accumulated_time_delta =
-            accumulated_time_delta - 1000.0 * (int)(accumulated_time_delta / 1000.0);
+        batch_start_ns = batch_end_ns;
     }
-    delete[] sin_phase_rad;
     delete[] package;
 }
 
 int SyntheticBoard::config_board (std::string config, std::string &response)
 {
+    if (config == "get_sampling_rate")
+    {
+        int rate = sampling_rate;
+        if (rate == 0)
+        {
+            try
+            {
+                rate = brainflow_boards_json["boards"][int_to_string (board_id)]["sampling_rate"];
+            }
+            catch (json::exception &e)
+            {
+                safe_logger (spdlog::level::err, e.what ());
+                return (int)BrainFlowExitCodes::GENERAL_ERROR;
+            }
+        }
+        response = std::to_string (rate);
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -1,5 +1,4 @@
 #include <math.h>
-#include <sstream>
 #include <stdexcept>
 #include <stdint.h>
 #include <stdio.h>
@@ -8,6 +7,9 @@
 #include <thread>
 #include <vector>
 
+#include "binary_file.h"
+#include "csv_reader.h"
+#include "ring_file.h"
 #include "brainflow_constants.h"
 #include "data_handler.h"
 #include "downsample_operators.h"
@@ -739,6 +741,23 @@ int write_file (double *data, int num_rows, int num_cols, char *file_name, char
         data_logger->error ("Incorrect file_mode. File_mode:{}", file_mode);
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    if (has_binary_extension (file_name))
+    {
+        // data is already channel-major, board id and channel types are unknown here
+        BinaryFileWriter writer;
+        int res = writer.open_file (file_name, file_mode, -1, num_rows, -1, NULL);
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = writer.write_samples (data, num_cols);
+            int close_res = writer.close_file ();
+            res = (res == (int)BrainFlowExitCodes::STATUS_OK) ? close_res : res;
+        }
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            data_logger->error ("Couldn't write binary file {}", file_name);
+        }
+        return res;
+    }
     FILE *fp;
     fp = fopen (file_name, file_mode);
     if (fp == NULL)
@@ -762,6 +781,21 @@ int write_file (double *data, int num_rows, int num_cols, char *file_name, char
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// binary and ring file readers write rows with stride max_samples, if less samples were read rows
+// are moved to stride num_samples which is returned as num_cols
+static void compact_rows (double *data, int num_rows, int64_t max_samples, int64_t num_samples)
+{
+    if (num_samples >= max_samples)
+    {
+        return;
+    }
+    for (int channel = 1; channel < num_rows; channel++)
+    {
+        memmove (data + channel * num_samples, data + channel * max_samples,
+            sizeof (double) * num_samples);
+    }
+}
+
 int read_file (double *data, int *num_rows, int *num_cols, char *file_name, int num_elements)
 {
     if (num_elements <= 0)
@@ -769,113 +803,124 @@ int read_file (double *data, int *num_rows, int *num_cols, char *file_name, int
         data_logger->error ("Nummber or elements must be greater than 0.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    FILE *fp;
-    fp = fopen (file_name, "r");
-    if (fp == NULL)
-    {
-        data_logger->error ("Couldn't read file {}", file_name);
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
-    }
-
-    char buf[4096];
-    // rows and cols in csv file, in data array its transposed!
-    int total_rows = 0;
-    int total_cols = 0;
-
-    // count rows
-    char c;
-    for (c = getc (fp); !feof (fp); c = getc (fp))
+    if (BinaryFileReader::is_binary_file (file_name))
     {
-        if (c == '\n')
+        BinaryFileReader reader;
+        if (reader.open_file (file_name) != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            data_logger->error ("Couldn't read binary file {}", file_name);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        int rows = reader.get_header ().num_rows;
+        int64_t max_samples = num_elements / rows;
+        if (max_samples > reader.get_header ().num_samples)
+        {
+            max_samples = reader.get_header ().num_samples;
+        }
+        int64_t num_samples = reader.read_samples (data, max_samples);
+        if (num_samples < max_samples)
         {
-            total_rows++;
+            data_logger->warn ("{} has only {} readable samples of {}", file_name, num_samples,
+                reader.get_header ().num_samples);
         }
+        compact_rows (data, rows, max_samples, num_samples);
+        *num_rows = rows;
+        *num_cols = (int)num_samples;
+        return (int)BrainFlowExitCodes::STATUS_OK;
     }
-
-    fseek (fp, 0, SEEK_SET);
-    int current_row = 0;
-    int cur_pos = 0;
-    while (fgets (buf, sizeof (buf), fp) != NULL)
+    // recovery of ring buffer stored by session with ring_file destination
+    if (RingFile::is_ring_file (file_name))
     {
-        std::string csv_string (buf);
-        std::stringstream ss (csv_string);
-        std::vector<std::string> splitted;
-        std::string tmp;
-        while (getline (ss, tmp, ','))
+        RingFile ring_file;
+        if (ring_file.open_file (file_name, "r", -1, 0, 0) != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            splitted.push_back (tmp);
+            data_logger->error ("Couldn't read ring file {}", file_name);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
-        total_cols = (int)splitted.size ();
-        for (int i = 0; i < total_cols; i++)
+        int rows = ring_file.get_header ()->num_rows;
+        int64_t max_samples = num_elements / rows;
+        if (max_samples > ring_file.get_num_samples ())
         {
-            data[i * total_rows + current_row] = std::stod (splitted[i]);
-            cur_pos++;
-            if (cur_pos == (num_elements - 1))
-            {
-                *num_cols = current_row + 1;
-                *num_rows = total_cols;
-                fclose (fp);
-                return (int)BrainFlowExitCodes::STATUS_OK;
-            }
+            max_samples = ring_file.get_num_samples ();
         }
-        current_row++;
+        int64_t num_samples = ring_file.read_samples (data, max_samples);
+        compact_rows (data, rows, max_samples, num_samples);
+        *num_rows = rows;
+        *num_cols = (int)num_samples;
+        return (int)BrainFlowExitCodes::STATUS_OK;
     }
-    // more likely code below is unreachable
-    *num_cols = total_rows;
+    CSVReader reader;
+    if (reader.open_file (file_name) != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Couldn't read file {}", file_name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // rows and cols in csv file, in data array its transposed!
+    int total_cols = reader.get_num_cols ();
+    if (total_cols == 0)
+    {
+        data_logger->error ("Empty file {}", file_name);
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    int64_t total_rows = reader.read_rows (data, num_elements / total_cols, true);
+    if (reader.get_num_skipped () > 0)
+    {
+        data_logger->warn ("{} rows in {} have invalid values or number of values different from "
+                           "the first row, they are skipped",
+            reader.get_num_skipped (), file_name);
+    }
+    *num_cols = (int)total_rows;
     *num_rows = total_cols;
-    fclose (fp);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int get_num_elements_in_file (char *file_name, int *num_elements)
 {
-    FILE *fp;
-    fp = fopen (file_name, "r");
-    if (fp == NULL)
+    if (BinaryFileReader::is_binary_file (file_name))
     {
-        data_logger->error ("Couldn't read file {}", file_name);
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        BinaryFileReader reader;
+        if (reader.open_file (file_name) != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            data_logger->error ("Couldn't read binary file {}", file_name);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        *num_elements = (int)(reader.get_header ().num_rows * reader.get_header ().num_samples);
+        if (*num_elements == 0)
+        {
+            data_logger->error ("Empty file {}", file_name);
+            return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+        }
+        return (int)BrainFlowExitCodes::STATUS_OK;
     }
-
-    char buf[4096];
-    int total_rows = 0;
-
-    // count rows
-    char c;
-    for (c = getc (fp); !feof (fp); c = getc (fp))
+    if (RingFile::is_ring_file (file_name))
     {
-        if (c == '\n')
+        RingFile ring_file;
+        if (ring_file.open_file (file_name, "r", -1, 0, 0) != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            data_logger->error ("Couldn't read ring file {}", file_name);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        *num_elements = (int)(ring_file.get_header ()->num_rows * ring_file.get_num_samples ());
+        if (*num_elements == 0)
         {
-            total_rows++;
+            data_logger->error ("Empty file {}", file_name);
+            return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
         }
+        return (int)BrainFlowExitCodes::STATUS_OK;
     }
-    if (total_rows == 0)
+    CSVReader reader;
+    if (reader.open_file (file_name) != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        *num_elements = 0;
-        fclose (fp);
-        data_logger->error ("Empty file {}", file_name);
-        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+        data_logger->error ("Couldn't read file {}", file_name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
-    fseek (fp, 0, SEEK_SET);
-    while (fgets (buf, sizeof (buf), fp) != NULL)
+    *num_elements = (int)(reader.get_num_cols () * reader.count_rows ());
+    if (*num_elements == 0)
     {
-        std::string csv_string (buf);
-        std::stringstream ss (csv_string);
-        std::vector<std::string> splitted;
-        std::string tmp;
-        while (getline (ss, tmp, ','))
-        {
-            splitted.push_back (tmp);
-        }
-        *num_elements = (int)splitted.size () * total_rows;
-        fclose (fp);
-        return (int)BrainFlowExitCodes::STATUS_OK;
+        data_logger->error ("Empty file {}", file_name);
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
     }
-    *num_elements = 0;
-    fclose (fp);
-    data_logger->error ("File contents", file_name);
-    return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int detrend (double *data, int data_len, int detrend_operation)
@@ -0,0 +1,569 @@
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "binary_file.h"
+#include "brainflow_constants.h"
+
+
+static int seek_file (FILE *fp, int64_t offset, int whence = SEEK_SET)
+{
+#ifdef _WIN32
+    return _fseeki64 (fp, offset, whence);
+#else
+    return fseeko (fp, (off_t)offset, whence);
+#endif
+}
+
+static int64_t tell_file (FILE *fp)
+{
+#ifdef _WIN32
+    return _ftelli64 (fp);
+#else
+    return (int64_t)ftello (fp);
+#endif
+}
+
+static int truncate_file (FILE *fp, int64_t size)
+{
+    if (fflush (fp) != 0)
+    {
+        return -1;
+    }
+#ifdef _WIN32
+    return (_chsize_s (_fileno (fp), size) == 0) ? 0 : -1;
+#else
+    return ftruncate (fileno (fp), (off_t)size);
+#endif
+}
+
+// blocks are aligned to 8 bytes
+static int64_t get_data_offset (int num_rows)
+{
+    int64_t offset = (int64_t)sizeof (struct BinaryFileHeader) + sizeof (int32_t) * num_rows;
+    return (offset + 7) & ~((int64_t)7);
+}
+
+static int64_t get_block_bytes (const struct BinaryFileHeader &header)
+{
+    return (int64_t)sizeof (double) * header.num_rows * header.block_size;
+}
+
+static int find_timestamp_channel (const int32_t *channel_map, int num_rows)
+{
+    if (channel_map == NULL)
+    {
+        return -1;
+    }
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (channel_map[i] == (int32_t)BinaryChannelType::TIMESTAMP)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool has_binary_extension (const char *file_name)
+{
+    size_t len = strlen (file_name);
+    size_t ext_len = strlen (BINARY_FILE_EXTENSION);
+    return (len > ext_len) && (strcmp (file_name + len - ext_len, BINARY_FILE_EXTENSION) == 0);
+}
+
+//////////////////////////////////////////////////////
+///////////////////// Reader /////////////////////////
+//////////////////////////////////////////////////////
+
+BinaryFileReader::BinaryFileReader ()
+{
+    fp = NULL;
+    memset (&header, 0, sizeof (header));
+    data_offset = 0;
+}
+
+BinaryFileReader::~BinaryFileReader ()
+{
+    close_file ();
+}
+
+bool BinaryFileReader::is_binary_file (const char *file_name)
+{
+    FILE *f = fopen (file_name, "rb");
+    if (f == NULL)
+    {
+        return false;
+    }
+    uint32_t magic = 0;
+    size_t res = fread (&magic, sizeof (magic), 1, f);
+    fclose (f);
+    return (res == 1) && (magic == BINARY_FILE_MAGIC);
+}
+
+int BinaryFileReader::open_file (const char *file_name)
+{
+    close_file ();
+    fp = fopen (file_name, "rb");
+    if (fp == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((fread (&header, sizeof (header), 1, fp) != 1) || (header.magic != BINARY_FILE_MAGIC) ||
+        (header.version != BINARY_FILE_VERSION) || (header.num_rows <= 0) ||
+        (header.block_size <= 0) || (header.num_samples < 0))
+    {
+        close_file ();
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    channel_map.resize (header.num_rows);
+    if (fread (channel_map.data (), sizeof (int32_t), header.num_rows, fp) !=
+        (size_t)header.num_rows)
+    {
+        close_file ();
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    data_offset = get_data_offset (header.num_rows);
+
+    seek_file (fp, 0, SEEK_END);
+    int64_t file_size = tell_file (fp);
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    if (header.index_offset == 0)
+    {
+        // writer was not closed properly, use complete blocks only
+        res = restore_index (file_size);
+    }
+    else
+    {
+        int64_t num_blocks = (header.num_samples + header.block_size - 1) / header.block_size;
+        if (header.index_offset + num_blocks * (int64_t)sizeof (struct BinaryBlockIndex) >
+            file_size)
+        {
+            res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        else
+        {
+            block_index.resize ((size_t)num_blocks);
+            seek_file (fp, header.index_offset);
+            if (fread (block_index.data (), sizeof (struct BinaryBlockIndex), block_index.size (),
+                    fp) != block_index.size ())
+            {
+                res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+        }
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        close_file ();
+    }
+    return res;
+}
+
+// num_samples is written before block index on close, if writer crashed earlier only complete
+// blocks are used and zero padding of the last one is dropped by zero timestamps
+int BinaryFileReader::restore_index (int64_t file_size)
+{
+    int64_t block_bytes = get_block_bytes (header);
+    int64_t num_blocks = (file_size > data_offset) ? (file_size - data_offset) / block_bytes : 0;
+    if (header.num_samples > 0)
+    {
+        int64_t written_blocks = (header.num_samples + header.block_size - 1) / header.block_size;
+        num_blocks = (written_blocks < num_blocks) ? written_blocks : num_blocks;
+    }
+    int timestamp_channel = get_timestamp_channel ();
+    block_index.resize ((size_t)num_blocks);
+    for (int64_t i = 0; i < num_blocks; i++)
+    {
+        block_index[i].offset = data_offset + i * block_bytes;
+        block_index[i].first_timestamp = 0.0;
+        if (timestamp_channel >= 0)
+        {
+            seek_file (fp, block_index[i].offset +
+                    (int64_t)sizeof (double) * timestamp_channel * header.block_size);
+            if (fread (&block_index[i].first_timestamp, sizeof (double), 1, fp) != 1)
+            {
+                return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+        }
+    }
+    int64_t num_samples = num_blocks * header.block_size;
+    if ((header.num_samples > 0) && (header.num_samples < num_samples))
+    {
+        num_samples = header.num_samples;
+    }
+    else if ((num_blocks > 0) && (timestamp_channel >= 0))
+    {
+        std::vector<double> timestamps (header.block_size);
+        seek_file (fp, block_index[num_blocks - 1].offset +
+                (int64_t)sizeof (double) * timestamp_channel * header.block_size);
+        if (fread (timestamps.data (), sizeof (double), timestamps.size (), fp) !=
+            timestamps.size ())
+        {
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        int len = header.block_size;
+        while ((len > 0) && (timestamps[len - 1] == 0.0))
+        {
+            len--;
+        }
+        num_samples -= header.block_size - len;
+        if (len == 0)
+        {
+            block_index.pop_back ();
+        }
+    }
+    header.num_samples = num_samples;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void BinaryFileReader::close_file ()
+{
+    if (fp != NULL)
+    {
+        fclose (fp);
+        fp = NULL;
+    }
+    block_index.clear ();
+    channel_map.clear ();
+}
+
+int BinaryFileReader::get_timestamp_channel () const
+{
+    return find_timestamp_channel (channel_map.data (), (int)channel_map.size ());
+}
+
+int BinaryFileReader::get_block_len (size_t block) const
+{
+    if (block >= block_index.size ())
+    {
+        return 0;
+    }
+    int64_t len = header.num_samples - (int64_t)block * header.block_size;
+    return (len > header.block_size) ? header.block_size : (int)len;
+}
+
+int BinaryFileReader::read_block (size_t block, double *block_buf)
+{
+    if ((fp == NULL) || (block >= block_index.size ()))
+    {
+        return -1;
+    }
+    size_t block_doubles = (size_t)header.num_rows * header.block_size;
+    if ((seek_file (fp, block_index[block].offset) != 0) ||
+        (fread (block_buf, sizeof (double), block_doubles, fp) != block_doubles))
+    {
+        return -1;
+    }
+    return get_block_len (block);
+}
+
+size_t BinaryFileReader::find_block (double timestamp) const
+{
+    // first_timestamp grows from block to block
+    size_t left = 0;
+    size_t right = block_index.size ();
+    while (right - left > 1)
+    {
+        size_t mid = left + (right - left) / 2;
+        if (block_index[mid].first_timestamp <= timestamp)
+        {
+            left = mid;
+        }
+        else
+        {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+int64_t BinaryFileReader::read_samples (double *data, int64_t max_samples)
+{
+    std::vector<double> block_buf ((size_t)header.num_rows * header.block_size);
+    int64_t total = 0;
+    for (size_t block = 0; (block < block_index.size ()) && (total < max_samples); block++)
+    {
+        int len = read_block (block, block_buf.data ());
+        if (len < 0)
+        {
+            break;
+        }
+        if (len > max_samples - total)
+        {
+            len = (int)(max_samples - total);
+        }
+        for (int channel = 0; channel < header.num_rows; channel++)
+        {
+            memcpy (data + channel * max_samples + total,
+                block_buf.data () + (size_t)channel * header.block_size, sizeof (double) * len);
+        }
+        total += len;
+    }
+    return total;
+}
+
+//////////////////////////////////////////////////////
+///////////////////// Writer /////////////////////////
+//////////////////////////////////////////////////////
+
+BinaryFileWriter::BinaryFileWriter ()
+{
+    fp = NULL;
+    memset (&header, 0, sizeof (header));
+    data_offset = 0;
+    block = NULL;
+    block_len = 0;
+    timestamp_channel = -1;
+}
+
+BinaryFileWriter::~BinaryFileWriter ()
+{
+    close_file ();
+}
+
+int BinaryFileWriter::open_file (const char *file_name, const char *file_mode, int board_id,
+    int num_rows, int sampling_rate, const int32_t *channel_map, int block_size)
+{
+    if ((strcmp (file_mode, "w") != 0) && (strcmp (file_mode, "w+") != 0) &&
+        (strcmp (file_mode, "a") != 0) && (strcmp (file_mode, "a+") != 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((num_rows <= 0) || (block_size <= 0) || (fp != NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    if (file_mode[0] == 'a')
+    {
+        FILE *existing = fopen (file_name, "rb");
+        if (existing != NULL)
+        {
+            seek_file (existing, 0, SEEK_END);
+            int64_t size = tell_file (existing);
+            fclose (existing);
+            if (size > 0)
+            {
+                return open_for_append (file_name, num_rows);
+            }
+        }
+    }
+
+    header.magic = BINARY_FILE_MAGIC;
+    header.version = BINARY_FILE_VERSION;
+    header.board_id = board_id;
+    header.num_rows = num_rows;
+    header.sampling_rate = sampling_rate;
+    header.block_size = block_size;
+    header.num_samples = 0;
+    header.index_offset = 0;
+    data_offset = get_data_offset (num_rows);
+    timestamp_channel = find_timestamp_channel (channel_map, num_rows);
+
+    fp = fopen (file_name, "wb");
+    if (fp == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    std::vector<int32_t> map (num_rows, (int32_t)BinaryChannelType::UNKNOWN);
+    if (channel_map != NULL)
+    {
+        memcpy (map.data (), channel_map, sizeof (int32_t) * num_rows);
+    }
+    std::vector<char> padding (
+        (size_t)(data_offset - sizeof (header) - sizeof (int32_t) * num_rows), 0);
+    bool is_ok = (fwrite (&header, sizeof (header), 1, fp) == 1) &&
+        (fwrite (map.data (), sizeof (int32_t), map.size (), fp) == map.size ()) &&
+        (fwrite (padding.data (), 1, padding.size (), fp) == padding.size ());
+    if (!is_ok)
+    {
+        fclose (fp);
+        fp = NULL;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    block = new double[(size_t)num_rows * block_size];
+    memset (block, 0, sizeof (double) * num_rows * block_size);
+    block_len = 0;
+    block_index.clear ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// keeps header of existing file, its last incomplete block is loaded and rewritten with new data
+int BinaryFileWriter::open_for_append (const char *file_name, int num_rows)
+{
+    BinaryFileReader reader;
+    int res = reader.open_file (file_name);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    header = reader.get_header ();
+    if (header.num_rows != num_rows)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    data_offset = get_data_offset (num_rows);
+    timestamp_channel = reader.get_timestamp_channel ();
+    block_index = reader.get_block_index ();
+    block = new double[(size_t)num_rows * header.block_size];
+    memset (block, 0, sizeof (double) * num_rows * header.block_size);
+    block_len = 0;
+    if (!block_index.empty ())
+    {
+        int last_len = reader.get_block_len (block_index.size () - 1);
+        if (last_len < header.block_size)
+        {
+            if (reader.read_block (block_index.size () - 1, block) < 0)
+            {
+                delete[] block;
+                block = NULL;
+                return (int)BrainFlowExitCodes::GENERAL_ERROR;
+            }
+            block_len = last_len;
+            header.num_samples -= last_len;
+            block_index.pop_back ();
+        }
+    }
+    reader.close_file ();
+
+    fp = fopen (file_name, "r+b");
+    if (fp == NULL)
+    {
+        delete[] block;
+        block = NULL;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    // old index and incomplete last block are cut off, so after a crash file has only complete
+    // blocks, mark file as not closed until new index is written
+    struct BinaryFileHeader unfinished = header;
+    unfinished.num_samples = 0;
+    unfinished.index_offset = 0;
+    int64_t rewrite_offset = data_offset + (int64_t)block_index.size () * get_block_bytes (header);
+    if ((truncate_file (fp, rewrite_offset) != 0) || (seek_file (fp, 0) != 0) ||
+        (fwrite (&unfinished, sizeof (unfinished), 1, fp) != 1))
+    {
+        fclose (fp);
+        fp = NULL;
+        delete[] block;
+        block = NULL;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::flush_block ()
+{
+    if (block_len == 0)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    // pad last block with zeros to keep blocks fixed size
+    for (int channel = 0; channel < header.num_rows; channel++)
+    {
+        memset (block + (size_t)channel * header.block_size + block_len, 0,
+            sizeof (double) * (header.block_size - block_len));
+    }
+    struct BinaryBlockIndex entry;
+    entry.offset = data_offset + (int64_t)block_index.size () * get_block_bytes (header);
+    entry.first_timestamp =
+        (timestamp_channel >= 0) ? block[(size_t)timestamp_channel * header.block_size] : 0.0;
+    size_t block_doubles = (size_t)header.num_rows * header.block_size;
+    if ((seek_file (fp, entry.offset) != 0) ||
+        (fwrite (block, sizeof (double), block_doubles, fp) != block_doubles))
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    block_index.push_back (entry);
+    header.num_samples += block_len;
+    block_len = 0;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::write_sample (const double *sample)
+{
+    if (fp == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    for (int channel = 0; channel < header.num_rows; channel++)
+    {
+        block[(size_t)channel * header.block_size + block_len] = sample[channel];
+    }
+    block_len++;
+    if (block_len == header.block_size)
+    {
+        return flush_block ();
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::write_samples (const double *data, int64_t num_samples)
+{
+    if (fp == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    int64_t pos = 0;
+    while (pos < num_samples)
+    {
+        int len = header.block_size - block_len;
+        if (len > num_samples - pos)
+        {
+            len = (int)(num_samples - pos);
+        }
+        for (int channel = 0; channel < header.num_rows; channel++)
+        {
+            memcpy (block + (size_t)channel * header.block_size + block_len,
+                data + channel * num_samples + pos, sizeof (double) * len);
+        }
+        block_len += len;
+        pos += len;
+        if (block_len == header.block_size)
+        {
+            int res = flush_block ();
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+        }
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::close_file ()
+{
+    if (fp == NULL)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    int res = flush_block ();
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        // num_samples lets reader drop padding and partially written index if we crash before
+        // index_offset is written
+        header.index_offset = 0;
+        bool is_ok =
+            (seek_file (fp, 0) == 0) && (fwrite (&header, sizeof (header), 1, fp) == 1);
+        header.index_offset =
+            data_offset + (int64_t)block_index.size () * get_block_bytes (header);
+        is_ok = is_ok && (seek_file (fp, header.index_offset) == 0) &&
+            (fwrite (block_index.data (), sizeof (struct BinaryBlockIndex), block_index.size (),
+                 fp) == block_index.size ()) &&
+            (seek_file (fp, 0) == 0) && (fwrite (&header, sizeof (header), 1, fp) == 1);
+        if (!is_ok)
+        {
+            res = (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+    }
+    fclose (fp);
+    fp = NULL;
+    delete[] block;
+    block = NULL;
+    block_len = 0;
+    block_index.clear ();
+    return res;
+}
@@ -61,6 +61,11 @@ int BroadCastClient::recv (void *data, int size)
     return res;
 }
 
+int BroadCastClient::recv_batch (DatagramBatch *batch)
+{
+    return batch->recv (connect_socket);
+}
+
 void BroadCastClient::close ()
 {
     closesocket (connect_socket);
@@ -119,6 +124,11 @@ int BroadCastClient::recv (void *data, int size)
     return res;
 }
 
+int BroadCastClient::recv_batch (DatagramBatch *batch)
+{
+    return batch->recv (connect_socket);
+}
+
 void BroadCastClient::close ()
 {
     ::close (connect_socket);
@@ -0,0 +1,137 @@
+#include <algorithm>
+
+#include "clock_sync.h"
+
+
+ClockSync::ClockSync (int window_size, int num_bins)
+{
+    this->num_bins = (num_bins < 2) ? 2 : num_bins;
+    this->window_size = (window_size < this->num_bins) ? this->num_bins : window_size;
+    min_points = this->num_bins / 4;
+    min_points = (min_points < 2) ? 2 : min_points;
+    device_times.resize (this->window_size);
+    residuals.resize (this->window_size);
+    bin_device_times.resize (this->num_bins);
+    bin_residuals.resize (this->num_bins);
+    values.reserve ((size_t)this->num_bins * this->num_bins);
+    // line changes slowly, refit a few times per bin
+    fit_interval = this->window_size / this->num_bins / 4;
+    fit_interval = (fit_interval < 1) ? 1 : fit_interval;
+    reset ();
+}
+
+void ClockSync::reset ()
+{
+    clear ();
+    num_resets = 0;
+}
+
+void ClockSync::clear ()
+{
+    count = 0;
+    pos = 0;
+    base_device_time = 0.0;
+    base_residual = 0.0;
+    last_device_time = 0.0;
+    slope = 0.0;
+    intercept = 0.0;
+    num_late_points = 0;
+    num_unfitted_points = 0;
+}
+
+void ClockSync::add (double device_time, double host_time)
+{
+    if (count > 0)
+    {
+        double deviation = host_time - to_host (device_time);
+        if ((device_time < last_device_time) || (deviation < -CLOCK_SYNC_MAX_JUMP))
+        {
+            clear ();
+            num_resets++;
+        }
+        else if (deviation > CLOCK_SYNC_MAX_JUMP)
+        {
+            // single late points are network stalls, dont use them
+            num_late_points++;
+            if (num_late_points < CLOCK_SYNC_MAX_LATE_POINTS)
+            {
+                return;
+            }
+            clear ();
+            num_resets++;
+        }
+        else
+        {
+            num_late_points = 0;
+        }
+    }
+    if (count == 0)
+    {
+        base_device_time = device_time;
+        base_residual = host_time - device_time;
+    }
+    last_device_time = device_time;
+    device_times[pos] = device_time - base_device_time;
+    residuals[pos] = host_time - device_time - base_residual;
+    pos = (pos + 1) % window_size;
+    count = (count < window_size) ? count + 1 : window_size;
+    num_unfitted_points++;
+    if ((count < num_bins) || (num_unfitted_points >= fit_interval))
+    {
+        fit ();
+    }
+}
+
+void ClockSync::fit ()
+{
+    num_unfitted_points = 0;
+    int first = (pos - count + window_size) % window_size;
+    int bins = (count < num_bins) ? count : num_bins;
+    // the least delayed point in each bin
+    for (int bin = 0; bin < bins; bin++)
+    {
+        int begin = (int)((long long)bin * count / bins);
+        int end = (int)((long long)(bin + 1) * count / bins);
+        int best = (first + begin) % window_size;
+        for (int i = begin + 1; i < end; i++)
+        {
+            int idx = (first + i) % window_size;
+            if (residuals[idx] < residuals[best])
+            {
+                best = idx;
+            }
+        }
+        bin_device_times[bin] = device_times[best];
+        bin_residuals[bin] = residuals[best];
+    }
+
+    double span = device_times[(first + count - 1) % window_size] - device_times[first];
+    slope = 0.0;
+    if ((bins >= 4) && (span >= CLOCK_SYNC_MIN_SKEW_SPAN))
+    {
+        values.clear ();
+        for (int i = 0; i < bins; i++)
+        {
+            for (int j = i + 1; j < bins; j++)
+            {
+                double dx = bin_device_times[j] - bin_device_times[i];
+                if (dx > 0)
+                {
+                    values.push_back ((bin_residuals[j] - bin_residuals[i]) / dx);
+                }
+            }
+        }
+        if (!values.empty ())
+        {
+            std::nth_element (values.begin (), values.begin () + values.size () / 2, values.end ());
+            slope = values[values.size () / 2];
+        }
+    }
+    values.clear ();
+    for (int i = 0; i < bins; i++)
+    {
+        values.push_back (bin_residuals[i] - slope * bin_device_times[i]);
+    }
+    std::nth_element (values.begin (), values.begin () + values.size () / 2, values.end ());
+    intercept = values[values.size () / 2];
+}
@@ -0,0 +1,527 @@
+#include <functional>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "brainflow_constants.h"
+#include "csv_reader.h"
+
+// mantissa should be exactly representable in double
+#define CSV_MAX_EXACT_MANTISSA (1ULL << 53)
+#define CSV_MAX_EXACT_EXPONENT 22
+#define CSV_MAX_TOKEN_LEN 63
+
+
+static const double exact_powers[CSV_MAX_EXACT_EXPONENT + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+    1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+    1e22};
+
+static inline bool is_space (char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+static inline bool is_digit (char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+// NULL if there is no '\n' in [p, end)
+static inline const char *find_newline (const char *p, const char *end)
+{
+    return (p < end) ? (const char *)memchr (p, '\n', (size_t)(end - p)) : NULL;
+}
+
+CSVReader::CSVReader ()
+{
+    map_begin = NULL;
+    map_size = 0;
+    begin = NULL;
+    end = NULL;
+    offset = 0;
+    end_offset = 0;
+    num_cols = 0;
+    num_skipped = 0;
+#ifdef _WIN32
+    file_handle = NULL;
+    mapping_handle = NULL;
+#endif
+}
+
+CSVReader::~CSVReader ()
+{
+    close_file ();
+}
+
+#ifdef _WIN32
+int CSVReader::open_file (const char *file_name, int64_t offset, bool complete_lines_only)
+{
+    close_file ();
+    HANDLE file = CreateFileA (file_name, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    file_handle = file;
+    LARGE_INTEGER size;
+    if ((!GetFileSizeEx (file, &size)) || (offset < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    this->offset = offset;
+    end_offset = offset;
+    if (size.QuadPart <= offset)
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    HANDLE mapping = CreateFileMappingA (file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    mapping_handle = mapping;
+    // view should start at allocation granularity
+    SYSTEM_INFO info;
+    GetSystemInfo (&info);
+    int64_t map_offset = offset - offset % info.dwAllocationGranularity;
+    map_size = (size_t)(size.QuadPart - map_offset);
+    void *addr = MapViewOfFile (mapping, FILE_MAP_READ, (DWORD)(map_offset >> 32),
+        (DWORD)(map_offset & 0xFFFFFFFF), map_size);
+    if (addr == NULL)
+    {
+        map_size = 0;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    map_begin = (char *)addr;
+    begin = map_begin + (offset - map_offset);
+    end = map_begin + map_size;
+#else
+int CSVReader::open_file (const char *file_name, int64_t offset, bool complete_lines_only)
+{
+    close_file ();
+    int fd = open (file_name, O_RDONLY);
+    if (fd < 0)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    struct stat st;
+    if ((fstat (fd, &st) != 0) || (offset < 0))
+    {
+        close (fd);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    this->offset = offset;
+    end_offset = offset;
+    if ((int64_t)st.st_size <= offset)
+    {
+        close (fd);
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    // mapping should start at page boundary
+    int64_t page_size = (int64_t)sysconf (_SC_PAGESIZE);
+    int64_t map_offset = offset - offset % page_size;
+    map_size = (size_t)(st.st_size - map_offset);
+    void *addr = mmap (NULL, map_size, PROT_READ, MAP_PRIVATE, fd, (off_t)map_offset);
+    close (fd); // mapping keeps file
+    if (addr == MAP_FAILED)
+    {
+        map_size = 0;
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise (addr, map_size, MADV_SEQUENTIAL);
+#endif
+    map_begin = (char *)addr;
+    begin = map_begin + (offset - map_offset);
+    end = map_begin + map_size;
+#endif
+    if (complete_lines_only)
+    {
+        while ((end > begin) && (*(end - 1) != '\n'))
+        {
+            end--;
+        }
+    }
+    // values in the first line
+    const char *line_end = find_newline (begin, end);
+    line_end = (line_end == NULL) ? end : line_end;
+    while ((line_end > begin) && (is_space (*(line_end - 1))))
+    {
+        line_end--;
+    }
+    num_cols = 0;
+    if (line_end > begin)
+    {
+        num_cols = 1;
+        for (const char *p = begin; p < line_end - 1; p++)
+        {
+            num_cols += (*p == ',');
+        }
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void CSVReader::close_file ()
+{
+#ifdef _WIN32
+    if (map_begin != NULL)
+    {
+        UnmapViewOfFile (map_begin);
+    }
+    if (mapping_handle != NULL)
+    {
+        CloseHandle ((HANDLE)mapping_handle);
+    }
+    if (file_handle != NULL)
+    {
+        CloseHandle ((HANDLE)file_handle);
+    }
+    file_handle = NULL;
+    mapping_handle = NULL;
+#else
+    if (map_begin != NULL)
+    {
+        munmap (map_begin, map_size);
+    }
+#endif
+    map_begin = NULL;
+    map_size = 0;
+    begin = NULL;
+    end = NULL;
+    num_skipped = 0;
+    chunks.clear ();
+}
+
+// chunks end after '\n', line counts are cached for read_rows
+void CSVReader::split_chunks (int num_threads)
+{
+    if (num_threads <= 0)
+    {
+        num_threads = (int)std::thread::hardware_concurrency ();
+    }
+    int64_t size = (int64_t)(end - begin);
+    int64_t max_chunks = size / CSV_READER_MIN_CHUNK_SIZE + 1;
+    int64_t num_chunks = num_threads;
+    num_chunks = (num_chunks > max_chunks) ? max_chunks : num_chunks;
+    num_chunks = (num_chunks > CSV_READER_MAX_THREADS) ? CSV_READER_MAX_THREADS : num_chunks;
+    num_chunks = (num_chunks < 1) ? 1 : num_chunks;
+    if ((!chunks.empty ()) && ((int64_t)chunks.size () == num_chunks))
+    {
+        return;
+    }
+
+    chunks.clear ();
+    const char *chunk_begin = begin;
+    for (int64_t i = 0; i < num_chunks; i++)
+    {
+        const char *chunk_end = end;
+        if (i < num_chunks - 1)
+        {
+            chunk_end = begin + size * (i + 1) / num_chunks;
+            chunk_end = (chunk_end < chunk_begin) ? chunk_begin : chunk_end;
+            const char *nl = find_newline (chunk_end, end);
+            chunk_end = (nl == NULL) ? end : nl + 1;
+        }
+        struct Chunk chunk = {chunk_begin, chunk_end, 0, 0};
+        chunks.push_back (chunk);
+        chunk_begin = chunk_end;
+    }
+
+    auto count = [] (struct Chunk *chunk) {
+        int64_t num_lines = 0;
+        const char *p = chunk->begin;
+        while (p < chunk->end)
+        {
+            const char *nl = find_newline (p, chunk->end);
+            num_lines++;
+            p = (nl == NULL) ? chunk->end : nl + 1;
+        }
+        chunk->num_lines = num_lines;
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < chunks.size (); i++)
+    {
+        threads.push_back (std::thread (count, &chunks[i]));
+    }
+    count (&chunks[0]);
+    for (std::thread &thread : threads)
+    {
+        thread.join ();
+    }
+    int64_t first_row = 0;
+    for (struct Chunk &chunk : chunks)
+    {
+        chunk.first_row = first_row;
+        first_row += chunk.num_lines;
+    }
+}
+
+int64_t CSVReader::count_rows (int num_threads)
+{
+    if (begin == end)
+    {
+        return 0;
+    }
+    split_chunks (num_threads);
+    return chunks.back ().first_row + chunks.back ().num_lines;
+}
+
+int64_t CSVReader::read_rows (double *data, int64_t max_rows, bool channel_major, int num_threads)
+{
+    num_skipped = 0;
+    int64_t num_lines = count_rows (num_threads);
+    num_lines = (num_lines > max_rows) ? max_rows : num_lines;
+    if ((num_lines <= 0) || (num_cols <= 0) || (data == NULL))
+    {
+        return 0;
+    }
+    // each line is parsed to its own slot, invalid ones are removed after that
+    row_valid.assign ((size_t)num_lines, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < chunks.size (); i++)
+    {
+        if (chunks[i].first_row < num_lines)
+        {
+            threads.push_back (std::thread (&CSVReader::parse_chunk, this, std::cref (chunks[i]),
+                num_lines, data, channel_major, num_lines));
+        }
+    }
+    parse_chunk (chunks[0], num_lines, data, channel_major, num_lines);
+    for (std::thread &thread : threads)
+    {
+        thread.join ();
+    }
+
+    // line after the last parsed one
+    end_offset = offset + (int64_t)(end - begin);
+    for (const struct Chunk &chunk : chunks)
+    {
+        if (chunk.first_row + chunk.num_lines > num_lines)
+        {
+            const char *p = chunk.begin;
+            for (int64_t i = chunk.first_row; i < num_lines; i++)
+            {
+                const char *nl = find_newline (p, chunk.end);
+                p = (nl == NULL) ? chunk.end : nl + 1;
+            }
+            end_offset = offset + (int64_t)(p - begin);
+            break;
+        }
+    }
+
+    int64_t num_rows = 0;
+    for (int64_t i = 0; i < num_lines; i++)
+    {
+        num_rows += row_valid[i];
+    }
+    num_skipped = num_lines - num_rows;
+    if ((num_skipped == 0) && (channel_major))
+    {
+        return num_rows;
+    }
+    // compact rows, stride of channel-major data becomes num_rows, destination never passes source
+    for (int col = 0; (col < num_cols) && (channel_major); col++)
+    {
+        int64_t row = 0;
+        for (int64_t i = 0; i < num_lines; i++)
+        {
+            if (row_valid[i])
+            {
+                data[col * num_rows + row++] = data[col * num_lines + i];
+            }
+        }
+    }
+    if (!channel_major)
+    {
+        int64_t row = 0;
+        for (int64_t i = 0; i < num_lines; i++)
+        {
+            if ((row_valid[i]) && (row != i))
+            {
+                memmove (data + row * num_cols, data + i * num_cols, sizeof (double) * num_cols);
+            }
+            row += row_valid[i];
+        }
+    }
+    return num_rows;
+}
+
+void CSVReader::parse_chunk (const struct Chunk &chunk, int64_t max_rows, double *data,
+    bool channel_major, int64_t stride)
+{
+    const char *p = chunk.begin;
+    for (int64_t row = chunk.first_row; (row < max_rows) && (p < chunk.end); row++)
+    {
+        const char *nl = find_newline (p, chunk.end);
+        const char *line_end = (nl == NULL) ? chunk.end : nl;
+        double *values = channel_major ? data + row : data + row * num_cols;
+        int64_t step = channel_major ? stride : 1;
+        row_valid[row] = (parse_line (p, line_end, values, step) == num_cols);
+        p = (nl == NULL) ? chunk.end : nl + 1;
+    }
+}
+
+int CSVReader::parse_line (
+    const char *line_begin, const char *line_end, double *values, int64_t step)
+{
+    while ((line_end > line_begin) && (is_space (*(line_end - 1))))
+    {
+        line_end--;
+    }
+    int col = 0;
+    const char *p = line_begin;
+    while (p < line_end)
+    {
+        if (col >= num_cols)
+        {
+            return -1;
+        }
+        double value = 0.0;
+        p = parse_double (p, line_end, &value);
+        if (p == NULL)
+        {
+            return -1;
+        }
+        values[col * step] = value;
+        col++;
+        if (p == line_end)
+        {
+            break;
+        }
+        // skip separator, separator at the end of line is allowed
+        p++;
+    }
+    return col;
+}
+
+const char *CSVReader::parse_double (const char *begin, const char *end, double *value)
+{
+    const char *p = begin;
+    while ((p < end) && (is_space (*p)))
+    {
+        p++;
+    }
+    bool negative = false;
+    if ((p < end) && ((*p == '-') || (*p == '+')))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int num_digits = 0; // significant digits in mantissa
+    int exponent = 0;
+    bool has_digits = false;
+    bool exact = true;
+    for (; (p < end) && (is_digit (*p)); p++)
+    {
+        has_digits = true;
+        if ((mantissa == 0) && (*p == '0'))
+        {
+            continue;
+        }
+        if (num_digits < 19)
+        {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            num_digits++;
+        }
+        else
+        {
+            exponent++;
+            exact = false;
+        }
+    }
+    if ((p < end) && (*p == '.'))
+    {
+        for (p++; (p < end) && (is_digit (*p)); p++)
+        {
+            has_digits = true;
+            if ((mantissa == 0) && (*p == '0'))
+            {
+                exponent--;
+                continue;
+            }
+            if (num_digits < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                num_digits++;
+                exponent--;
+            }
+            else
+            {
+                exact = false;
+            }
+        }
+    }
+    if ((has_digits) && (p < end) && ((*p == 'e') || (*p == 'E')))
+    {
+        const char *exp_begin = p++;
+        bool exp_negative = false;
+        if ((p < end) && ((*p == '-') || (*p == '+')))
+        {
+            exp_negative = (*p == '-');
+            p++;
+        }
+        int exp_value = 0;
+        bool has_exp_digits = false;
+        for (; (p < end) && (is_digit (*p)); p++)
+        {
+            has_exp_digits = true;
+            exp_value = (exp_value < 10000) ? exp_value * 10 + (*p - '0') : exp_value;
+        }
+        if (!has_exp_digits)
+        {
+            p = exp_begin;
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    while ((p < end) && (is_space (*p)))
+    {
+        p++;
+    }
+    bool at_separator = (p == end) || (*p == ',');
+
+    if ((has_digits) && (at_separator) && (exact) && (mantissa <= CSV_MAX_EXACT_MANTISSA) &&
+        (exponent >= -CSV_MAX_EXACT_EXPONENT) && (exponent <= CSV_MAX_EXACT_EXPONENT))
+    {
+        double result = (double)mantissa;
+        result = (exponent < 0) ? result / exact_powers[-exponent] :
+                                  result * exact_powers[exponent];
+        *value = negative ? -result : result;
+        return p;
+    }
+
+    // nan, inf, too many digits or big exponent
+    const char *token_end =
+        (begin < end) ? (const char *)memchr (begin, ',', (size_t)(end - begin)) : NULL;
+    token_end = (token_end == NULL) ? end : token_end;
+    size_t len = (size_t)(token_end - begin);
+    if ((len == 0) || (len > CSV_MAX_TOKEN_LEN))
+    {
+        return NULL;
+    }
+    char token[CSV_MAX_TOKEN_LEN + 1];
+    memcpy (token, begin, len);
+    token[len] = '\0';
+    char *parsed_end = NULL;
+    double result = strtod (token, &parsed_end);
+    while ((parsed_end != NULL) && (is_space (*parsed_end)))
+    {
+        parsed_end++;
+    }
+    if ((parsed_end == token) || (parsed_end == NULL) || (*parsed_end != '\0'))
+    {
+        return NULL;
+    }
+    *value = result;
+    return token_end;
+}
@@ -1,16 +1,51 @@
+#include <chrono>
+
 #include "data_buffer.h"
 
-DataBuffer::DataBuffer (int num_samples, size_t buffer_size)
+DataBuffer::DataBuffer (
+    int num_samples, size_t buffer_size, SampleFormat format, int timestamp_channel)
+    : layout (num_samples, buffer_size, format, timestamp_channel)
 {
     this->buffer_size = buffer_size;
     this->num_samples = num_samples;
-    data = new double[buffer_size * num_samples];
-    first_free = first_used = count = 0;
+    data = new char[layout.get_size ()];
+    write_pos = 0;
+    read_pos = 0;
+    wake_pos = UINT64_MAX;
+    closed = false;
+    ring_file = NULL;
+    persistent_head = NULL;
+    persistent_tail = NULL;
+}
+
+DataBuffer::DataBuffer (RingFile *ring_file)
+    : layout (ring_file->get_header ()->num_rows, (size_t)ring_file->get_header ()->buffer_size,
+          (SampleFormat)ring_file->get_header ()->sample_format,
+          ring_file->get_header ()->timestamp_channel)
+{
+    struct RingFileHeader *header = ring_file->get_header ();
+    this->buffer_size = (size_t)header->buffer_size;
+    this->num_samples = (size_t)header->num_rows;
+    this->ring_file = ring_file;
+    data = ring_file->get_data ();
+    persistent_head = &header->head;
+    persistent_tail = &header->tail;
+    write_pos = persistent_head->load (std::memory_order_acquire);
+    read_pos = persistent_tail->load (std::memory_order_acquire);
+    wake_pos = UINT64_MAX;
+    closed = false;
 }
 
 DataBuffer::~DataBuffer ()
 {
-    delete[] data;
+    if (ring_file != NULL)
+    {
+        delete ring_file;
+    }
+    else
+    {
+        delete[] data;
+    }
 }
 
 bool DataBuffer::is_ready ()
@@ -18,73 +53,239 @@ bool DataBuffer::is_ready ()
     return (data != NULL);
 }
 
+// called only from one thread, never blocks
 void DataBuffer::add_data (double *value)
 {
-    lock.lock ();
-    memcpy (this->data + first_free * num_samples, value, sizeof (double) * num_samples);
-    first_free = next (first_free);
-    count++;
-    if (first_free == first_used)
+    uint64_t pos = write_pos.load (std::memory_order_relaxed);
+    // dont let writes to the slot become visible before previous position was published, readers
+    // rely on it to detect overwritten data
+    std::atomic_thread_fence (std::memory_order_release);
+    layout.write (data, (size_t)(pos % buffer_size), value);
+    write_pos.store (pos + 1, std::memory_order_release);
+    if (persistent_head != NULL)
+    {
+        persistent_head->store (pos + 1, std::memory_order_release);
+    }
+    // pairs with the fence in wait_for_data: either waiter sees new write_pos or producer sees its
+    // wake_pos, without waiters it costs a fence and a load
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    if (pos + 1 >= wake_pos.load (std::memory_order_relaxed))
     {
-        first_used = next (first_used);
-        count--;
+        std::lock_guard<std::mutex> lk (wait_lock);
+        wake_pos.store (UINT64_MAX, std::memory_order_relaxed);
+        wait_cv.notify_all ();
     }
-    lock.unlock ();
 }
 
-void DataBuffer::get_chunk (size_t start, size_t size, double *data_buf)
+// slot for position 'write' may be under modification right now, it shares memory with the oldest
+// one, so buffer holds at most buffer_size - 1 valid samples
+uint64_t DataBuffer::first_available (uint64_t read, uint64_t write)
 {
-    if (start + size < buffer_size)
+    if (write + 1 > buffer_size)
     {
-        memcpy (data_buf, data + start * num_samples, size * sizeof (double) * num_samples);
+        uint64_t oldest = write + 1 - buffer_size;
+        if (read < oldest)
+        {
+            return oldest;
+        }
     }
-    else
+    return read;
+}
+
+void DataBuffer::get_chunk (size_t start, size_t size, double *data_buf, size_t stride)
+{
+    size_t first_half = buffer_size - start;
+    if (first_half > size)
     {
-        size_t first_half = buffer_size - start;
-        size_t second_half = size - first_half;
-        memcpy (data_buf, data + start * num_samples, first_half * sizeof (double) * num_samples);
-        memcpy (
-            data_buf + first_half * num_samples, data, second_half * sizeof (double) * num_samples);
+        first_half = size;
+    }
+    size_t second_half = size - first_half;
+    // float channels are converted to double here, stored data is never exposed
+    layout.read (data, start, first_half, data_buf, stride);
+    if (second_half)
+    {
+        layout.read (data, 0, second_half, data_buf + first_half, stride);
     }
 }
 
-// removes data from buffer
-size_t DataBuffer::get_data (size_t max_count, double *data_buf)
+// copies samples [start, start + size) to the first columns of data_buf, returns number of leading
+// samples which were overwritten by producer during copying
+size_t DataBuffer::copy_and_validate (uint64_t start, size_t size, double *data_buf, size_t stride)
+{
+    get_chunk ((size_t)(start % buffer_size), size, data_buf, stride);
+    std::atomic_thread_fence (std::memory_order_acquire);
+    uint64_t oldest = first_available (start, write_pos.load (std::memory_order_relaxed));
+    if (oldest - start > size)
+    {
+        return size;
+    }
+    return (size_t)(oldest - start);
+}
+
+// moves valid columns [lost, size) of each channel to the beginning, rows are processed in order
+// and new_stride <= stride so nothing is overwritten before it is moved
+void DataBuffer::drop_leading (
+    double *data_buf, size_t stride, size_t size, size_t lost, size_t new_stride)
+{
+    for (size_t i = 0; i < num_samples; i++)
+    {
+        memmove (data_buf + i * new_stride, data_buf + i * stride + lost,
+            (size - lost) * sizeof (double));
+    }
+}
+
+// moves channels stored with stride to new_stride >= stride and zeroes samples after count,
+// channels are moved from the last one to not overwrite data which is not moved yet
+void DataBuffer::widen_stride (double *data_buf, size_t stride, size_t count, size_t new_stride)
+{
+    for (size_t i = num_samples; i-- > 0;)
+    {
+        memmove (data_buf + i * new_stride, data_buf + i * stride, count * sizeof (double));
+        memset (data_buf + i * new_stride + count, 0, (new_stride - count) * sizeof (double));
+    }
+}
+
+// copies up to max_count samples starting from *pos and moves *pos past them, samples which were
+// overwritten before or during copying are skipped and added to *lost, channels in data_buf are
+// stored with *stride >= returned count
+size_t DataBuffer::copy_from (
+    uint64_t *pos, size_t max_count, double *data_buf, uint64_t *lost, size_t *stride)
 {
-    lock.lock ();
+    uint64_t write = write_pos.load (std::memory_order_acquire);
+    uint64_t start = first_available (*pos, write);
+    *lost += start - *pos;
     size_t result_count = max_count;
-    if (result_count > count)
-        result_count = count;
-    if (result_count)
+    if (result_count > write - start)
+        result_count = (size_t)(write - start);
+
+    size_t filled = 0;
+    uint64_t current = start;
+    while (filled < result_count)
+    {
+        uint64_t next = first_available (current, write);
+        *lost += next - current;
+        current = next;
+        size_t chunk_size = result_count - filled;
+        if (chunk_size > write - current)
+            chunk_size = (size_t)(write - current);
+        if (chunk_size == 0)
+        {
+            break;
+        }
+        size_t chunk_lost =
+            copy_and_validate (current, chunk_size, data_buf + filled, result_count);
+        if (chunk_lost)
+        {
+            drop_leading (data_buf + filled, result_count, chunk_size, chunk_lost, result_count);
+            *lost += chunk_lost;
+        }
+        filled += chunk_size - chunk_lost;
+        current += chunk_size;
+        write = write_pos.load (std::memory_order_acquire);
+    }
+    *pos = current;
+    *stride = result_count;
+    return filled;
+}
+
+// removes data from buffer, channels have stride max_count like callers allocate them, if fewer
+// samples are available or some were overwritten during copying the rest of each channel is zero
+size_t DataBuffer::get_data (size_t max_count, double *data_buf)
+{
+    std::lock_guard<std::mutex> lock (read_lock);
+    uint64_t pos = read_pos.load (std::memory_order_relaxed);
+    uint64_t lost = 0;
+    size_t stride = 0;
+    size_t filled = copy_from (&pos, max_count, data_buf, &lost, &stride);
+    if (filled < max_count)
+    {
+        widen_stride (data_buf, stride, filled, max_count);
+    }
+    read_pos.store (pos, std::memory_order_release);
+    if (persistent_tail != NULL)
+    {
+        persistent_tail->store (pos, std::memory_order_release);
+    }
+    return filled;
+}
+
+// doesn't remove data from buffer and doesn't lock readers, cursor is owned by caller
+size_t DataBuffer::read_since (uint64_t *cursor, size_t max_count, double *data_buf, uint64_t *lost)
+{
+    size_t stride = 0;
+    size_t filled = copy_from (cursor, max_count, data_buf, lost, &stride);
+    // unlike get_data result always has stride equal to returned count
+    if (filled < stride)
     {
-        get_chunk (first_used, result_count, data_buf);
-        first_used = (first_used + result_count) % buffer_size;
-        count -= result_count;
+        drop_leading (data_buf, stride, filled, 0, filled);
     }
-    lock.unlock ();
-    return result_count;
+    return filled;
+}
+
+size_t DataBuffer::get_data_count_since (uint64_t cursor, uint64_t *lost)
+{
+    uint64_t write = write_pos.load (std::memory_order_acquire);
+    uint64_t start = first_available (cursor, write);
+    *lost = start - cursor;
+    return (size_t)(write - start);
 }
 
 // doesn't remove data from buffer
 size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
 {
-    lock.lock ();
+    std::lock_guard<std::mutex> lock (read_lock);
+    uint64_t write = write_pos.load (std::memory_order_acquire);
+    uint64_t start = first_available (read_pos.load (std::memory_order_relaxed), write);
     size_t result_count = max_count;
-    if (result_count > count)
-        result_count = count;
-    if (result_count)
+    if (result_count > write - start)
+        result_count = (size_t)(write - start);
+    if (result_count == 0)
+    {
+        return 0;
+    }
+    size_t lost = copy_and_validate (write - result_count, result_count, data_buf, result_count);
+    if (lost)
     {
-        size_t first_return = (first_used + (count - result_count)) % buffer_size;
-        get_chunk (first_return, result_count, data_buf);
+        drop_leading (data_buf, result_count, result_count, lost, result_count - lost);
     }
-    lock.unlock ();
-    return result_count;
+    return result_count - lost;
 }
 
 size_t DataBuffer::get_data_count ()
 {
-    lock.lock ();
-    size_t result = this->count;
-    lock.unlock ();
-    return result;
+    uint64_t write = write_pos.load (std::memory_order_acquire);
+    uint64_t start = first_available (read_pos.load (std::memory_order_acquire), write);
+    return (size_t)(write - start);
+}
+
+size_t DataBuffer::wait_for_data (size_t min_count, int timeout_ms)
+{
+    auto deadline = std::chrono::steady_clock::now () + std::chrono::milliseconds (timeout_ms);
+    std::unique_lock<std::mutex> lk (wait_lock);
+    while (true)
+    {
+        // readers may move read_pos while we wait, so target is recalculated after each wake up
+        uint64_t target = read_pos.load (std::memory_order_acquire) + min_count;
+        if (target < wake_pos.load (std::memory_order_relaxed))
+        {
+            wake_pos.store (target, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        size_t count = get_data_count ();
+        if ((count >= min_count) || (closed))
+        {
+            return count;
+        }
+        if (wait_cv.wait_until (lk, deadline) == std::cv_status::timeout)
+        {
+            return get_data_count ();
+        }
+    }
+}
+
+void DataBuffer::close ()
+{
+    std::lock_guard<std::mutex> lk (wait_lock);
+    closed = true;
+    wait_cv.notify_all ();
 }
@@ -0,0 +1,117 @@
+#include <string.h>
+
+#include "datagram_batch.h"
+#include "timestamp.h"
+
+
+DatagramBatch::DatagramBatch (int max_datagram_size, int max_datagrams)
+{
+    this->max_datagram_size = (max_datagram_size < 1) ? 1 : max_datagram_size;
+    this->max_datagrams = (max_datagrams < 1) ? 1 : max_datagrams;
+    num_datagrams = 0;
+    arena.resize ((size_t)this->max_datagram_size * this->max_datagrams);
+    sizes.resize (this->max_datagrams, 0);
+    timestamps.resize (this->max_datagrams, 0.0);
+    kernel_timestamps.resize (this->max_datagrams, 0);
+#if defined(__linux__)
+    // buffers dont move, so headers are prepared once
+    iovecs.resize (this->max_datagrams);
+    messages.resize (this->max_datagrams);
+    control_size = (int)CMSG_SPACE (sizeof (struct timespec));
+    controls.resize ((size_t)control_size * this->max_datagrams);
+    for (int i = 0; i < this->max_datagrams; i++)
+    {
+        iovecs[i].iov_base = get_datagram (i);
+        iovecs[i].iov_len = (size_t)this->max_datagram_size;
+        memset (&messages[i], 0, sizeof (messages[i]));
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_control = controls.data () + (size_t)i * control_size;
+    }
+#endif
+}
+
+///////////////////////////////
+/////////// WINDOWS ///////////
+//////////////////////////////
+#ifdef _WIN32
+
+int DatagramBatch::recv (SOCKET socket)
+{
+    num_datagrams = 0;
+    int res = recvfrom (socket, (char *)get_datagram (0), max_datagram_size, 0, NULL, NULL);
+    if (res == SOCKET_ERROR)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    timestamps[0] = ::get_timestamp ();
+    kernel_timestamps[0] = 0;
+    num_datagrams = 1;
+    return num_datagrams;
+}
+
+///////////////////////////////
+//////////// LINUX ////////////
+///////////////////////////////
+#elif defined(__linux__)
+
+int DatagramBatch::recv (int socket)
+{
+    num_datagrams = 0;
+    for (int i = 0; i < max_datagrams; i++)
+    {
+        // kernel overwrites it with size of received control data
+        messages[i].msg_hdr.msg_controllen = (size_t)control_size;
+    }
+    // MSG_WAITFORONE: wait with socket timeout for the first datagram only
+    int res =
+        recvmmsg (socket, messages.data (), (unsigned int)max_datagrams, MSG_WAITFORONE, NULL);
+    if (res < 0)
+    {
+        return -1;
+    }
+    double recv_time = ::get_timestamp ();
+    for (int i = 0; i < res; i++)
+    {
+        sizes[i] = (int)messages[i].msg_len;
+        timestamps[i] = recv_time;
+        kernel_timestamps[i] = 0;
+        struct msghdr *hdr = &messages[i].msg_hdr;
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR (hdr); cmsg != NULL;
+             cmsg = CMSG_NXTHDR (hdr, cmsg))
+        {
+            if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+            {
+                struct timespec ts;
+                memcpy (&ts, CMSG_DATA (cmsg), sizeof (ts));
+                timestamps[i] = (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+                kernel_timestamps[i] = 1;
+            }
+        }
+    }
+    num_datagrams = res;
+    return num_datagrams;
+}
+
+///////////////////////////////
+//////////// UNIX /////////////
+///////////////////////////////
+#else
+
+int DatagramBatch::recv (int socket)
+{
+    num_datagrams = 0;
+    int res = (int)recvfrom (socket, get_datagram (0), (size_t)max_datagram_size, 0, NULL, NULL);
+    if (res < 0)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    timestamps[0] = ::get_timestamp ();
+    kernel_timestamps[0] = 0;
+    num_datagrams = 1;
+    return num_datagrams;
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include <string.h>
+
+#include "frame_decoder.h"
+
+
+FrameDecoder::FrameDecoder (unsigned char start_byte, unsigned char end_byte_min,
+    unsigned char end_byte_max, int min_frame_size, int max_frame_size, int buffer_size)
+{
+    this->start_byte = start_byte;
+    this->end_byte_min = end_byte_min;
+    this->end_byte_max = end_byte_max;
+    this->min_frame_size = min_frame_size;
+    this->max_frame_size = (max_frame_size < min_frame_size) ? min_frame_size : max_frame_size;
+    // variable size frame is complete only when start byte of the next one arrives
+    int min_buffer_size = 2 * (this->max_frame_size + 1);
+    buffer.resize ((buffer_size < min_buffer_size) ? min_buffer_size : buffer_size);
+    head = 0;
+    tail = 0;
+    num_skipped_bytes = 0;
+}
+
+void FrameDecoder::reset ()
+{
+    head = 0;
+    tail = 0;
+    num_skipped_bytes = 0;
+}
+
+void FrameDecoder::compact ()
+{
+    if (head == 0)
+    {
+        return;
+    }
+    if (tail > head)
+    {
+        memmove (buffer.data (), buffer.data () + head, tail - head);
+    }
+    tail -= head;
+    head = 0;
+}
+
+int FrameDecoder::read_from (Serial *serial)
+{
+    compact ();
+    int free_space = (int)buffer.size () - tail;
+    if (free_space <= 0)
+    {
+        // cant happen, next_frame consumes bytes which dont belong to a frame
+        reset ();
+        free_space = (int)buffer.size ();
+    }
+    // windows ReadFile returns only when requested size is read or line is idle, so asking for
+    // the whole buffer would delay packages, read queued bytes or one frame if nothing is queued
+    int size = free_space;
+    int queued = serial->get_bytes_available ();
+    if (queued >= 0)
+    {
+        size = (queued > 0) ? queued : min_frame_size;
+        size = (size > free_space) ? free_space : size;
+    }
+    int res = serial->read_from_serial_port (buffer.data () + tail, size);
+    if (res <= 0)
+    {
+        return 0;
+    }
+    tail += res;
+    return res;
+}
+
+int FrameDecoder::add_bytes (const unsigned char *bytes, int size)
+{
+    compact ();
+    int free_space = (int)buffer.size () - tail;
+    size = (size > free_space) ? free_space : size;
+    if (size > 0)
+    {
+        memcpy (buffer.data () + tail, bytes, size);
+        tail += size;
+    }
+    return (size > 0) ? size : 0;
+}
+
+FrameStatus FrameDecoder::next_frame (unsigned char **frame, int *size)
+{
+    unsigned char *data = buffer.data ();
+    while (head < tail)
+    {
+        if (data[head] != start_byte)
+        {
+            unsigned char *start =
+                (unsigned char *)memchr (data + head, start_byte, (size_t)(tail - head));
+            int new_head = (start == NULL) ? tail : (int)(start - data);
+            num_skipped_bytes += new_head - head;
+            head = new_head;
+            continue;
+        }
+        if (tail - head < min_frame_size)
+        {
+            return FrameStatus::NO_FRAME;
+        }
+        int frame_size = 0;
+        if (min_frame_size == max_frame_size)
+        {
+            if (is_end_byte (data[head + min_frame_size - 1]))
+            {
+                frame_size = min_frame_size;
+            }
+        }
+        else
+        {
+            // end byte at pos closes the frame if start byte follows it
+            int last = head + max_frame_size - 1;
+            int pos = head + min_frame_size - 1;
+            for (; (pos <= last) && (pos + 1 < tail); pos++)
+            {
+                if ((data[pos + 1] == start_byte) && (is_end_byte (data[pos])))
+                {
+                    frame_size = pos + 1 - head;
+                    break;
+                }
+            }
+            if ((frame_size == 0) && (pos <= last))
+            {
+                // need more bytes to decide
+                return FrameStatus::NO_FRAME;
+            }
+        }
+        *frame = data + head + 1;
+        if (frame_size == 0)
+        {
+            // drop start byte only, real frame may start inside of this one
+            *size = min_frame_size - 1;
+            head++;
+            return FrameStatus::INVALID;
+        }
+        *size = frame_size - 1;
+        head += frame_size;
+        return FrameStatus::VALID;
+    }
+    return FrameStatus::NO_FRAME;
+}
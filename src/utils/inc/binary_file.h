@@ -0,0 +1,145 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#define BINARY_FILE_MAGIC 0x31424642 // "BFB1"
+#define BINARY_FILE_VERSION 1
+#define BINARY_FILE_EXTENSION ".bfb"
+#define DEFAULT_BINARY_BLOCK_SIZE 256
+
+
+// meaning of each row, stored in file header to make recordings self-describing
+enum class BinaryChannelType : int32_t
+{
+    UNKNOWN = 0,
+    PACKAGE_NUM = 1,
+    TIMESTAMP = 2,
+    MARKER = 3,
+    BATTERY = 4,
+    EEG = 5,
+    EMG = 6,
+    ECG = 7,
+    EOG = 8,
+    ACCEL = 9,
+    GYRO = 10,
+    ANALOG = 11,
+    EDA = 12,
+    PPG = 13,
+    TEMPERATURE = 14,
+    RESISTANCE = 15,
+    OTHER = 16
+};
+
+// layout of binary recording(native byte order, little endian on all supported platforms):
+// BinaryFileHeader | int32 channel_map[num_rows] | padding to 8 bytes | blocks | block index
+// each block holds block_size samples stored channel-major: block[channel * block_size + sample],
+// last block is padded with zeros, block index is written on close, num_samples and index_offset
+// are 0 until then and reader restores them from complete blocks, dropping trailing samples with
+// zero timestamp. Appending cuts off incomplete last block and index before writing new blocks
+struct BinaryFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t board_id;      // -1 if unknown
+    int32_t num_rows;      // channels in each sample
+    int32_t sampling_rate; // -1 if unknown
+    int32_t block_size;    // samples in each block
+    int64_t num_samples;
+    int64_t index_offset;
+};
+
+struct BinaryBlockIndex
+{
+    int64_t offset;
+    double first_timestamp; // 0 if there is no timestamp channel
+};
+
+class BinaryFileReader
+{
+
+public:
+    BinaryFileReader ();
+    ~BinaryFileReader ();
+
+    // returns BrainFlowExitCodes
+    int open_file (const char *file_name);
+    void close_file ();
+
+    const struct BinaryFileHeader &get_header () const
+    {
+        return header;
+    }
+    const std::vector<int32_t> &get_channel_map () const
+    {
+        return channel_map;
+    }
+    const std::vector<struct BinaryBlockIndex> &get_block_index () const
+    {
+        return block_index;
+    }
+    size_t get_num_blocks () const
+    {
+        return block_index.size ();
+    }
+    // row with BinaryChannelType::TIMESTAMP or -1
+    int get_timestamp_channel () const;
+    // number of valid samples in block
+    int get_block_len (size_t block) const;
+    // reads whole block to buffer with size num_rows * block_size, returns number of valid samples
+    // or -1 on error
+    int read_block (size_t block, double *block_buf);
+    // last block with first_timestamp <= timestamp, 0 if there is no such block
+    size_t find_block (double timestamp) const;
+    // copies up to max_samples to data in channel-major layout data[channel * max_samples + i],
+    // returns number of samples read
+    int64_t read_samples (double *data, int64_t max_samples);
+
+    // checks magic without opening file for reading
+    static bool is_binary_file (const char *file_name);
+
+private:
+    FILE *fp;
+    struct BinaryFileHeader header;
+    std::vector<int32_t> channel_map;
+    std::vector<struct BinaryBlockIndex> block_index;
+    int64_t data_offset;
+
+    int restore_index (int64_t file_size);
+};
+
+// writes samples one by one or in chunks, whole blocks are written at once
+class BinaryFileWriter
+{
+
+public:
+    BinaryFileWriter ();
+    ~BinaryFileWriter ();
+
+    // file_mode is w, w+, a or a+, appending to existing binary file keeps its header and requires
+    // the same num_rows, channel_map has num_rows elements or is NULL, returns BrainFlowExitCodes
+    int open_file (const char *file_name, const char *file_mode, int board_id, int num_rows,
+        int sampling_rate, const int32_t *channel_map, int block_size = DEFAULT_BINARY_BLOCK_SIZE);
+    // writes last block and block index, returns BrainFlowExitCodes
+    int close_file ();
+
+    int write_sample (const double *sample);
+    // data in channel-major layout data[channel * num_samples + i]
+    int write_samples (const double *data, int64_t num_samples);
+
+private:
+    FILE *fp;
+    struct BinaryFileHeader header;
+    std::vector<struct BinaryBlockIndex> block_index;
+    int64_t data_offset;
+    double *block;
+    int block_len;
+    int timestamp_channel;
+
+    int open_for_append (const char *file_name, int num_rows);
+    int flush_block ();
+};
+
+// binary format is chosen for files with BINARY_FILE_EXTENSION
+bool has_binary_extension (const char *file_name);
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+#define CLOCK_SYNC_WINDOW_SIZE 2048
+#define CLOCK_SYNC_NUM_BINS 32
+// device time span needed to fit skew, offset only is used before
+#define CLOCK_SYNC_MIN_SKEW_SPAN 10.0
+// bigger difference with fitted line means that one of clocks was changed
+#define CLOCK_SYNC_MAX_JUMP 1.0
+// consecutive late points needed to treat delay as a clock jump
+#define CLOCK_SYNC_MAX_LATE_POINTS 16
+
+
+// maps device clock to host clock for boards which send device timestamps. Pairs of device time
+// and host arrival time are kept in a sliding window, arrival time is late by network and scheduler
+// delay, so the line is fitted to the lower envelope: window is split into bins, the least delayed
+// point of each bin is taken and skew is a median of slopes between them(Theil-Sen), offset is a
+// median of intercepts. Result includes minimal delay, boards subtract it if they know it
+class ClockSync
+{
+
+public:
+    ClockSync (int window_size = CLOCK_SYNC_WINDOW_SIZE, int num_bins = CLOCK_SYNC_NUM_BINS);
+
+    // restarts fitting if device time goes back or clocks jump
+    void add (double device_time, double host_time);
+    void reset ();
+    bool is_ready () const
+    {
+        return count >= min_points;
+    }
+    double to_host (double device_time) const
+    {
+        return device_time + base_residual + intercept + slope * (device_time - base_device_time);
+    }
+    // host seconds per device second
+    double get_skew () const
+    {
+        return 1.0 + slope;
+    }
+    int get_num_resets () const
+    {
+        return num_resets;
+    }
+
+private:
+    int window_size;
+    int num_bins;
+    int min_points;
+    int fit_interval;
+    // device time and host - device time relative to the first point after reset
+    std::vector<double> device_times;
+    std::vector<double> residuals;
+    int count;
+    int pos;
+    double base_device_time;
+    double base_residual;
+    double last_device_time;
+    double slope;
+    double intercept;
+    int num_late_points;
+    int num_unfitted_points;
+    int num_resets;
+    // preallocated for fit
+    std::vector<double> bin_device_times;
+    std::vector<double> bin_residuals;
+    std::vector<double> values;
+
+    // drops window, but keeps number of resets
+    void clear ();
+    void fit ();
+};
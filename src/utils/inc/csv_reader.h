@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// smaller parts of file are not worth a thread
+#define CSV_READER_MIN_CHUNK_SIZE (4 * 1024 * 1024)
+#define CSV_READER_MAX_THREADS 8
+
+
+// csv file with numbers separated by ',' mapped to memory and parsed in place without
+// allocations per row or value. Rows are lines of any length, separator at the end of row and '\r'
+// are ignored, rows with number of values different from num_cols are skipped. Big files are
+// split into chunks at line boundaries, chunks are counted and parsed by several threads
+class CSVReader
+{
+
+public:
+    CSVReader ();
+    ~CSVReader ();
+
+    // maps file from offset in bytes to its current end, if complete_lines_only is set line
+    // without '\n' at the end is not read(file may be still written), returns BrainFlowExitCodes
+    int open_file (const char *file_name, int64_t offset = 0, bool complete_lines_only = false);
+    void close_file ();
+
+    // number of values in the first row unless it's set explicitly, 0 for empty file
+    int get_num_cols () const
+    {
+        return num_cols;
+    }
+    void set_num_cols (int num_cols)
+    {
+        this->num_cols = num_cols;
+    }
+    // number of lines including invalid ones, num_threads 0 means number of cores
+    int64_t count_rows (int num_threads = 0);
+    // parses up to max_rows lines to data[col * num_rows + row] if channel_major or to
+    // data[row * num_cols + col] otherwise, data has space for max_rows * num_cols values,
+    // invalid lines are skipped, returns number of valid rows
+    int64_t read_rows (double *data, int64_t max_rows, bool channel_major, int num_threads = 0);
+    // rows skipped by the last read_rows
+    int64_t get_num_skipped () const
+    {
+        return num_skipped;
+    }
+    // offset in file after the last line parsed by read_rows, next open_file may continue from it
+    int64_t get_end_offset () const
+    {
+        return end_offset;
+    }
+
+    // parses one value from [begin, end) up to ',' or end, digits are converted with exact fast
+    // path for up to 19 significant digits and exponent up to 22, strtod is used otherwise,
+    // returns position of ',' or end, NULL if value is invalid
+    static const char *parse_double (const char *begin, const char *end, double *value);
+
+private:
+    struct Chunk
+    {
+        const char *begin;
+        const char *end;
+        int64_t num_lines;
+        int64_t first_row;
+    };
+
+    char *map_begin;
+    size_t map_size;
+    const char *begin;
+    const char *end;
+    int64_t offset;
+    int64_t end_offset;
+    int num_cols;
+    int64_t num_skipped;
+    std::vector<struct Chunk> chunks;
+    std::vector<char> row_valid;
+#ifdef _WIN32
+    void *file_handle;
+    void *mapping_handle;
+#endif
+
+    void split_chunks (int num_threads);
+    // returns number of values in line or -1 if line is invalid, values are written with step
+    int parse_line (const char *line_begin, const char *line_end, double *values, int64_t step);
+    void parse_chunk (const struct Chunk &chunk, int64_t max_rows, double *data,
+        bool channel_major, int64_t stride);
+};
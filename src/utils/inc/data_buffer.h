@@ -1,34 +1,86 @@
 #pragma once
 
-#include "spinlock.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "ring_file.h"
+#include "sample_format.h"
+
+// ring buffer with a single producer(board read thread) and any number of readers, producer never
+// waits for readers: readers copy data without locking and validate it after copying, samples
+// overwritten by producer during copying are dropped
+// each channel is stored in its own contiguous ring and data is returned in the same channel-major
+// layout: data_buf[channel * returned_count + sample], so reading is up to two memcpy per channel.
+// With SampleFormat::FLOAT32 channels except timestamp are stored as floats and converted to
+// doubles during reading
 class DataBuffer
 {
 
-    SpinLock lock;
-    double *data;
+    char *data;
+    SampleLayout layout;
 
     size_t buffer_size;
-    size_t first_used, first_free;
-    size_t count;
     size_t num_samples;
 
-    size_t next (size_t index)
-    {
-        return (index + 1) % buffer_size;
-    }
+    // monotonic positions, slot in data is position % buffer_size
+    std::atomic<uint64_t> write_pos;
+    std::atomic<uint64_t> read_pos;
+    // serializes readers between each other, never locked by producer
+    std::mutex read_lock;
+    // position of write_pos which the earliest waiter needs, UINT64_MAX if there are no waiters,
+    // producer checks it after each sample and locks wait_lock only to wake waiters up
+    std::atomic<uint64_t> wake_pos;
+    std::mutex wait_lock;
+    std::condition_variable wait_cv;
+    bool closed;
+    // optional memory mapped storage, positions are mirrored to its header
+    RingFile *ring_file;
+    std::atomic<uint64_t> *persistent_head;
+    std::atomic<uint64_t> *persistent_tail;
 
-    void get_chunk (size_t start, size_t size, double *data_buf);
+    uint64_t first_available (uint64_t read, uint64_t write);
+    void get_chunk (size_t start, size_t size, double *data_buf, size_t stride);
+    size_t copy_and_validate (uint64_t start, size_t size, double *data_buf, size_t stride);
+    void drop_leading (
+        double *data_buf, size_t stride, size_t size, size_t lost, size_t new_stride);
+    void widen_stride (double *data_buf, size_t stride, size_t count, size_t new_stride);
+    size_t copy_from (
+        uint64_t *pos, size_t max_count, double *data_buf, uint64_t *lost, size_t *stride);
 
 public:
-    DataBuffer (int num_samples, size_t buffer_size);
+    DataBuffer (int num_samples, size_t buffer_size, SampleFormat format = SampleFormat::FLOAT64,
+        int timestamp_channel = -1);
+    // takes ownership of opened ring file, samples which are already in file are available
+    DataBuffer (RingFile *ring_file);
     ~DataBuffer ();
 
     void add_data (double *value);
+    // data_buf[channel * max_count + sample], samples after returned count are zero
     size_t get_data (size_t max_count, double *data_buf);
     size_t get_current_data (size_t max_count, double *data_buf);
     size_t get_data_count ();
+    // reader cursor is a position in the stream: get_write_pos () for new samples only, 0 for all
+    // samples. read_since copies samples after cursor without removing them for other readers and
+    // advances cursor, samples overwritten by producer before reading are skipped and counted in
+    // lost
+    size_t read_since (uint64_t *cursor, size_t max_count, double *data_buf, uint64_t *lost);
+    // samples available for cursor, lost is set to number of samples already overwritten
+    size_t get_data_count_since (uint64_t cursor, uint64_t *lost);
+    uint64_t get_write_pos ()
+    {
+        return write_pos.load (std::memory_order_acquire);
+    }
+    // blocks until there are at least min_count samples, timeout or close, returns data count
+    size_t wait_for_data (size_t min_count, int timeout_ms);
+    // wakes up waiters, buffer will not get new data
+    void close ();
+    size_t get_max_count ()
+    {
+        return buffer_size - 1;
+    }
     bool is_ready ();
 };
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#endif
+
+#include <vector>
+
+#define DATAGRAM_BATCH_DEFAULT_SIZE 64
+
+
+// preallocated storage for datagrams received with a single call, on linux recvmmsg fills all
+// slots which have data without blocking after the first datagram, other systems receive one
+// datagram per call. If SO_TIMESTAMPNS is enabled for socket each datagram has kernel arrival time,
+// otherwise time when recv returned
+class DatagramBatch
+{
+
+public:
+    DatagramBatch (int max_datagram_size, int max_datagrams = DATAGRAM_BATCH_DEFAULT_SIZE);
+
+    // returns number of received datagrams, blocks until the first one or socket timeout, returns
+    // -1 on error or timeout
+#ifdef _WIN32
+    int recv (SOCKET socket);
+#else
+    int recv (int socket);
+#endif
+
+    int get_num_datagrams () const
+    {
+        return num_datagrams;
+    }
+    unsigned char *get_datagram (int i)
+    {
+        return arena.data () + (size_t)i * max_datagram_size;
+    }
+    // datagrams bigger than max_datagram_size are truncated
+    int get_size (int i) const
+    {
+        return sizes[i];
+    }
+    // unix time in seconds
+    double get_timestamp (int i) const
+    {
+        return timestamps[i];
+    }
+    bool is_kernel_timestamp (int i) const
+    {
+        return kernel_timestamps[i] != 0;
+    }
+    int get_max_datagram_size () const
+    {
+        return max_datagram_size;
+    }
+
+private:
+    int max_datagram_size;
+    int max_datagrams;
+    int num_datagrams;
+    std::vector<unsigned char> arena;
+    std::vector<int> sizes;
+    std::vector<double> timestamps;
+    std::vector<char> kernel_timestamps;
+#if defined(__linux__)
+    std::vector<struct iovec> iovecs;
+    std::vector<struct mmsghdr> messages;
+    std::vector<char> controls;
+    int control_size;
+#endif
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "serial.h"
+
+// enough for ~0.3s of data at 115200 baud
+#define FRAME_DECODER_BUFFER_SIZE 4096
+
+
+enum class FrameStatus : int
+{
+    NO_FRAME = 0,
+    VALID = 1,
+    INVALID = 2
+};
+
+// finds packages framed by start and end bytes in serial stream. Bytes are read with a single call
+// as many as fit to the buffer and all complete frames are returned in place without copies. If
+// min_frame_size == max_frame_size frame has fixed size and ends with end byte in
+// [end_byte_min, end_byte_max], otherwise frame is closed by end byte followed by start byte of the
+// next frame. After invalid frame decoder resyncs from the next start byte
+class FrameDecoder
+{
+
+public:
+    // frame sizes include start and end bytes
+    FrameDecoder (unsigned char start_byte, unsigned char end_byte_min, unsigned char end_byte_max,
+        int min_frame_size, int max_frame_size, int buffer_size = FRAME_DECODER_BUFFER_SIZE);
+
+    // reads queued bytes or waits for one frame if nothing is queued, returns number of bytes
+    // read, 0 on timeout or error
+    int read_from (Serial *serial);
+    // copies bytes to buffer as if they were read, returns number of bytes added
+    int add_bytes (const unsigned char *bytes, int size);
+    // frame points to the byte after start byte, size doesnt include start byte, so for valid frame
+    // frame[size - 1] is end byte. Frame data is valid until the next read_from or add_bytes
+    FrameStatus next_frame (unsigned char **frame, int *size);
+    void reset ();
+
+    // bytes dropped while searching for start byte, doesnt include invalid frames
+    uint64_t get_num_skipped_bytes () const
+    {
+        return num_skipped_bytes;
+    }
+
+private:
+    unsigned char start_byte;
+    unsigned char end_byte_min;
+    unsigned char end_byte_max;
+    int min_frame_size;
+    int max_frame_size;
+    std::vector<unsigned char> buffer;
+    int head;
+    int tail;
+    uint64_t num_skipped_bytes;
+
+    bool is_end_byte (unsigned char byte) const
+    {
+        return (byte >= end_byte_min) && (byte <= end_byte_max);
+    }
+    // moves unprocessed bytes to the beginning of buffer
+    void compact ();
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// bounded lock-free queue for several producers and one consumer, capacity is a power of two.
+// Each cell has a sequence number: producer claims position with CAS and publishes cell by
+// setting sequence to position + 1, consumer frees it by setting sequence to position + capacity
+template <typename T, size_t capacity> class MPSCQueue
+{
+    static_assert ((capacity >= 2) && ((capacity & (capacity - 1)) == 0),
+        "capacity should be a power of two");
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Cell cells[capacity];
+    std::atomic<size_t> enqueue_pos;
+    size_t dequeue_pos; // used only by consumer
+
+public:
+    MPSCQueue ()
+    {
+        for (size_t i = 0; i < capacity; i++)
+        {
+            cells[i].sequence.store (i, std::memory_order_relaxed);
+        }
+        enqueue_pos.store (0, std::memory_order_relaxed);
+        dequeue_pos = 0;
+    }
+
+    // returns false if queue is full, never blocks
+    bool push (const T &value)
+    {
+        size_t pos = enqueue_pos.load (std::memory_order_relaxed);
+        while (true)
+        {
+            Cell *cell = &cells[pos & (capacity - 1)];
+            size_t sequence = cell->sequence.load (std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (enqueue_pos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell->value = value;
+                    cell->sequence.store (pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // called only from consumer thread, returns false if queue is empty
+    bool pop (T *value)
+    {
+        Cell *cell = &cells[dequeue_pos & (capacity - 1)];
+        size_t sequence = cell->sequence.load (std::memory_order_acquire);
+        if (sequence != dequeue_pos + 1)
+        {
+            return false;
+        }
+        *value = cell->value;
+        cell->sequence.store (dequeue_pos + capacity, std::memory_order_release);
+        dequeue_pos++;
+        return true;
+    }
+};
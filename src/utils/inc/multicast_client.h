@@ -11,6 +11,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "datagram_batch.h"
+
 
 enum class MultiCastReturnCodes : int
 {
@@ -34,6 +36,9 @@ public:
 
     int init ();
     int recv (void *data, int size);
+    // receives all available datagrams with one call if system supports it, returns number of
+    // datagrams or -1
+    int recv_batch (DatagramBatch *batch);
     void close ();
 
 
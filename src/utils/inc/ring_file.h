@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sample_format.h"
+
+#define RING_FILE_MAGIC 0x52424642 // "BFBR"
+#define RING_FILE_VERSION 1
+// data starts at page boundary
+#define RING_FILE_DATA_OFFSET 4096
+
+
+// layout of ring file(native byte order): RingFileHeader | padding to RING_FILE_DATA_OFFSET | data
+// data has the same SampleLayout as DataBuffer: each channel in its own ring of buffer_size.
+// head and tail are monotonic positions of writer and destructive reader, slot is
+// position % buffer_size, producer publishes head after sample is written so after crash of the
+// process samples [max (tail, head + 1 - buffer_size), head) are valid
+struct RingFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t board_id;
+    int32_t num_rows;
+    uint64_t buffer_size;
+    uint64_t data_offset;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    int32_t sample_format; // SampleFormat
+    int32_t timestamp_channel;
+};
+
+// file mapped to memory which backs DataBuffer, survives crash of the process(but not of the OS)
+class RingFile
+{
+
+public:
+    RingFile ();
+    ~RingFile ();
+
+    // file_mode is w to create new file, a to continue existing one(new file is created if there
+    // is no such file) or r for recovery, huge pages are used only if file is in hugetlbfs, for
+    // other filesystems they are only a hint, returns BrainFlowExitCodes
+    // format and timestamp_channel are used only for new file
+    int open_file (const char *file_name, const char *file_mode, int board_id, int num_rows,
+        size_t buffer_size, bool huge_pages = false, SampleFormat format = SampleFormat::FLOAT64,
+        int timestamp_channel = -1);
+    void close_file ();
+
+    struct RingFileHeader *get_header ()
+    {
+        return header;
+    }
+    char *get_data ()
+    {
+        return data;
+    }
+    // true only if mapping is backed by hugetlbfs
+    bool is_huge_pages () const
+    {
+        return huge_pages_used;
+    }
+    // number of valid samples between tail and head
+    int64_t get_num_samples () const;
+    // copies up to max_samples oldest valid samples in channel-major layout
+    // data[channel * max_samples + i], returns number of samples
+    int64_t read_samples (double *data_buf, int64_t max_samples) const;
+
+    // checks magic without mapping file
+    static bool is_ring_file (const char *file_name);
+
+private:
+    struct RingFileHeader *header;
+    char *data;
+    size_t mapped_size;
+    bool huge_pages_used;
+#ifdef _WIN32
+    void *file_handle;
+    void *mapping_handle;
+#else
+    int fd;
+#endif
+
+    int map_file (const char *file_name, bool create, bool read_only, size_t file_size);
+    uint64_t first_valid () const;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+
+
+// paces read threads of generated or recorded data: deadlines are absolute offsets from start on
+// monotonic clock so sleep errors dont accumulate, timestamps are wall clock at start plus offset
+// so they dont drift from pacing and cost no syscall per sample
+class SampleClock
+{
+
+public:
+    SampleClock ();
+
+    // sets base for offsets and timestamps
+    void start ();
+    // nanoseconds since start
+    int64_t get_elapsed_ns ();
+    // returns immediately if deadline has already passed
+    void sleep_until (int64_t offset_ns);
+    double get_timestamp (int64_t offset_ns) const
+    {
+        return wall_base + offset_ns / 1e9;
+    }
+
+    static int64_t get_monotonic_ns ();
+
+private:
+    int64_t monotonic_base;
+    double wall_base;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+enum class SampleFormat : int32_t
+{
+    FLOAT64 = 0,
+    // all channels except timestamp are stored as float, 24 bit adc values and counters fit it
+    FLOAT32 = 1
+};
+
+// returns false for unknown names, known names are float64 and float32
+inline bool parse_sample_format (const std::string &name, SampleFormat *format)
+{
+    if (name == "float64")
+    {
+        *format = SampleFormat::FLOAT64;
+        return true;
+    }
+    if (name == "float32")
+    {
+        *format = SampleFormat::FLOAT32;
+        return true;
+    }
+    return false;
+}
+
+// loops are simple enough to be vectorized by compiler
+inline void convert_to_float (const double *src, float *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = (float)src[i];
+    }
+}
+
+inline void convert_to_double (const float *src, double *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = (double)src[i];
+    }
+}
+
+// where each channel is stored: channel-major rings of ring_size elements, channels stored as
+// doubles go first to keep them aligned, then float channels in the same order. Package is a ring
+// with ring_size 1
+class SampleLayout
+{
+
+public:
+    SampleLayout (int num_rows, size_t ring_size, SampleFormat format, int timestamp_channel)
+    {
+        this->num_rows = num_rows;
+        this->ring_size = ring_size;
+        this->format = format;
+        int num_double_rows = num_rows;
+        if (format == SampleFormat::FLOAT32)
+        {
+            num_double_rows =
+                ((timestamp_channel >= 0) && (timestamp_channel < num_rows)) ? 1 : 0;
+        }
+        size_t double_offset = 0;
+        size_t float_offset = sizeof (double) * ring_size * num_double_rows;
+        for (int i = 0; i < num_rows; i++)
+        {
+            bool is_float = (format == SampleFormat::FLOAT32) && (i != timestamp_channel);
+            float_channels.push_back (is_float ? 1 : 0);
+            if (is_float)
+            {
+                offsets.push_back (float_offset);
+                float_offset += sizeof (float) * ring_size;
+            }
+            else
+            {
+                offsets.push_back (double_offset);
+                double_offset += sizeof (double) * ring_size;
+            }
+        }
+        size = float_offset;
+    }
+
+    bool is_float (int channel) const
+    {
+        return (float_channels[channel] != 0);
+    }
+
+    // offset of the first element of channel in bytes
+    size_t get_offset (int channel) const
+    {
+        return offsets[channel];
+    }
+
+    size_t get_size () const
+    {
+        return size;
+    }
+
+    SampleFormat get_format () const
+    {
+        return format;
+    }
+
+    // copies count elements of each channel starting from position start of storage to data_buf,
+    // channel i goes to data_buf + i * stride, start + count <= ring_size
+    void read (
+        const char *storage, size_t start, size_t count, double *data_buf, size_t stride) const
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            const char *ring = storage + offsets[i];
+            double *output = data_buf + i * stride;
+            if (float_channels[i])
+            {
+                convert_to_double ((const float *)ring + start, output, count);
+            }
+            else
+            {
+                memcpy (output, (const double *)ring + start, count * sizeof (double));
+            }
+        }
+    }
+
+    // writes one package to position pos of storage
+    void write (char *storage, size_t pos, const double *package) const
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            char *ring = storage + offsets[i];
+            if (float_channels[i])
+            {
+                ((float *)ring)[pos] = (float)package[i];
+            }
+            else
+            {
+                ((double *)ring)[pos] = package[i];
+            }
+        }
+    }
+
+private:
+    int num_rows;
+    size_t ring_size;
+    SampleFormat format;
+    size_t size;
+    std::vector<size_t> offsets;
+    std::vector<char> float_channels;
+};
@@ -30,6 +30,11 @@ public:
     virtual int set_custom_baudrate (int baudrate) = 0;
     virtual int flush_buffer () = 0;
     virtual int read_from_serial_port (void *bytes_to_read, int size) = 0;
+    // bytes which can be read without waiting, -1 if unknown
+    virtual int get_bytes_available ()
+    {
+        return -1;
+    }
     virtual int send_to_serial_port (const void *message, int length) = 0;
     virtual int close_serial_port () = 0;
     virtual const char *get_port_name () = 0;
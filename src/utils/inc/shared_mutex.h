@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+
+// readers-writer lock for c++11(std::shared_mutex requires c++17), writers have priority: new
+// readers wait if there is a writer waiting for the lock
+class SharedMutex
+{
+    std::mutex m;
+    std::condition_variable cv;
+    int num_readers = 0;
+    int num_waiting_writers = 0;
+    bool has_writer = false;
+
+public:
+    inline void lock ()
+    {
+        std::unique_lock<std::mutex> lk (m);
+        num_waiting_writers++;
+        cv.wait (lk, [this] { return (!has_writer) && (num_readers == 0); });
+        num_waiting_writers--;
+        has_writer = true;
+    }
+
+    inline void unlock ()
+    {
+        std::lock_guard<std::mutex> lk (m);
+        has_writer = false;
+        cv.notify_all ();
+    }
+
+    inline void lock_shared ()
+    {
+        std::unique_lock<std::mutex> lk (m);
+        cv.wait (lk, [this] { return (!has_writer) && (num_waiting_writers == 0); });
+        num_readers++;
+    }
+
+    inline void unlock_shared ()
+    {
+        std::lock_guard<std::mutex> lk (m);
+        num_readers--;
+        if (num_readers == 0)
+        {
+            cv.notify_all ();
+        }
+    }
+};
+
+// analog of std::shared_lock, holds SharedMutex in shared mode until destruction
+class SharedLock
+{
+    SharedMutex &shared_mutex;
+
+public:
+    explicit SharedLock (SharedMutex &shared_mutex) : shared_mutex (shared_mutex)
+    {
+        shared_mutex.lock_shared ();
+    }
+
+    ~SharedLock ()
+    {
+        shared_mutex.unlock_shared ();
+    }
+
+    SharedLock (const SharedLock &) = delete;
+    SharedLock &operator= (const SharedLock &) = delete;
+};
@@ -11,6 +11,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "datagram_batch.h"
+
 
 enum class SocketClientUDPReturnCodes : int
 {
@@ -19,7 +21,8 @@ enum class SocketClientUDPReturnCodes : int
     CREATE_SOCKET_ERROR = 2,
     CONNECT_ERROR = 3,
     PTON_ERROR = 4,
-    INVALID_ARGUMENT_ERROR = 5
+    INVALID_ARGUMENT_ERROR = 5,
+    SET_OPT_ERROR = 6
 };
 
 
@@ -38,8 +41,13 @@ public:
     int connect ();
     int bind ();
     int set_timeout (int num_seconds);
+    // datagrams received with recv_batch get kernel arrival time, linux only
+    int enable_kernel_timestamps ();
     int send (const char *data, int size);
     int recv (void *data, int size);
+    // receives all available datagrams with one call if system supports it, returns number of
+    // datagrams or -1
+    int recv_batch (DatagramBatch *batch);
     void close ();
     int get_local_ip_addr (const char *local_ip);
     char *get_ip_addr ()
@@ -8,10 +8,13 @@
 #include <unistd.h>
 #endif
 
-#include <queue>
 #include <stdlib.h>
 #include <string.h>
 #include <thread>
+#include <vector>
+
+// initial size of receive buffer, recv reads as much as fits into it with one call
+#define SOCKET_SERVER_TCP_BUFFER_SIZE 65536
 
 enum class SocketServerTCPReturnCodes : int
 {
@@ -19,7 +22,8 @@ enum class SocketServerTCPReturnCodes : int
     WSA_STARTUP_ERROR = 1,
     CREATE_SOCKET_ERROR = 2,
     CONNECT_ERROR = 3,
-    PTON_ERROR = 4
+    PTON_ERROR = 4,
+    SET_OPT_ERROR = 5
 };
 
 
@@ -35,9 +39,20 @@ public:
 
     int bind ();
     int accept ();
+    // call before accept, connected socket will report kernel arrival time of data, linux only
+    int enable_kernel_timestamps ();
+    // if recv_all_or_nothing returns size or 0, otherwise returns up to size bytes
     int recv (void *data, int size);
+    // copies all complete frames received so far but not more than max_frames to data, returns
+    // number of frames
+    int recv_frames (void *data, int frame_size, int max_frames);
     void close ();
     void accept_worker ();
+    // arrival time of the last received bytes, kernel time if enabled or time when recv returned
+    double get_recv_timestamp ()
+    {
+        return recv_timestamp;
+    }
 
     volatile bool client_connected; // idea - stop accept blocking call by calling close in
                                     // another thread
@@ -47,11 +62,21 @@ private:
     int local_port;
     struct sockaddr_in server_addr;
     volatile struct sockaddr_in client_addr;
-    std::queue<char> temp_buffer;
+    // received bytes are in [head, tail), unread bytes are moved to the beginning before recv
+    std::vector<char> buffer;
+    int head;
+    int tail;
     bool recv_all_or_nothing;
+    bool kernel_timestamps;
+    double recv_timestamp;
 
     std::thread accept_thread;
 
+    // moves unread bytes to the beginning, grows buffer to have at least min_free space
+    void prepare_buffer (int min_free);
+    // receives as many bytes as fit to buffer with one call
+    int fill_buffer (int min_free);
+
 #ifdef _WIN32
     volatile SOCKET server_socket;
     volatile SOCKET connected_socket;
@@ -91,6 +91,11 @@ int MultiCastClient::recv (void *data, int size)
     return res;
 }
 
+int MultiCastClient::recv_batch (DatagramBatch *batch)
+{
+    return batch->recv (client_socket);
+}
+
 void MultiCastClient::close ()
 {
     closesocket (client_socket);
@@ -178,6 +183,11 @@ int MultiCastClient::recv (void *data, int size)
     return res;
 }
 
+int MultiCastClient::recv_batch (DatagramBatch *batch)
+{
+    return batch->recv (client_socket);
+}
+
 void MultiCastClient::close ()
 {
     ::close (client_socket);
@@ -89,6 +89,17 @@ int OSSerial::read_from_serial_port (void *bytes_to_read, int size)
     return (int)readed;
 }
 
+int OSSerial::get_bytes_available ()
+{
+    COMSTAT status;
+    DWORD errors;
+    if (ClearCommError (this->port_descriptor, &errors, &status) == 0)
+    {
+        return -1;
+    }
+    return (int)status.cbInQue;
+}
+
 int OSSerial::send_to_serial_port (const void *message, int length)
 {
     DWORD bytes_written;
@@ -116,6 +127,7 @@ int OSSerial::close_serial_port ()
 #else
 
 #include <fcntl.h>
+#include <sys/ioctl.h>
 #include <termios.h>
 #include <unistd.h>
 
@@ -182,6 +194,16 @@ int OSSerial::read_from_serial_port (void *bytes_to_read, int size)
     return res;
 }
 
+int OSSerial::get_bytes_available ()
+{
+    int queued = 0;
+    if (ioctl (this->port_descriptor, FIONREAD, &queued) != 0)
+    {
+        return -1;
+    }
+    return queued;
+}
+
 int OSSerial::flush_buffer ()
 {
     tcflush (this->port_descriptor, TCIOFLUSH);
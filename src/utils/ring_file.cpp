@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/vfs.h>
+#endif
+
+#include "brainflow_constants.h"
+#include "ring_file.h"
+
+// hugetlbfs requires file size to be a multiple of huge page size
+#define RING_FILE_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define RING_FILE_HUGETLBFS_MAGIC 0x958458f6
+
+
+RingFile::RingFile ()
+{
+    header = NULL;
+    data = NULL;
+    mapped_size = 0;
+    huge_pages_used = false;
+#ifdef _WIN32
+    file_handle = NULL;
+    mapping_handle = NULL;
+#else
+    fd = -1;
+#endif
+}
+
+RingFile::~RingFile ()
+{
+    close_file ();
+}
+
+bool RingFile::is_ring_file (const char *file_name)
+{
+    FILE *f = fopen (file_name, "rb");
+    if (f == NULL)
+    {
+        return false;
+    }
+    uint32_t magic = 0;
+    size_t res = fread (&magic, sizeof (magic), 1, f);
+    fclose (f);
+    return (res == 1) && (magic == RING_FILE_MAGIC);
+}
+
+int RingFile::open_file (const char *file_name, const char *file_mode, int board_id, int num_rows,
+    size_t buffer_size, bool huge_pages, SampleFormat format, int timestamp_channel)
+{
+    close_file ();
+    if ((file_name == NULL) || (file_mode == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    bool read_only = (strcmp (file_mode, "r") == 0);
+    bool create = (strcmp (file_mode, "w") == 0);
+    if ((strcmp (file_mode, "a") == 0) && (!is_ring_file (file_name)))
+    {
+        create = true;
+    }
+    if ((!read_only) && (!create) && (strcmp (file_mode, "a") != 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    size_t file_size = 0;
+    if (create)
+    {
+        if ((num_rows <= 0) || (buffer_size < 2))
+        {
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        SampleLayout layout (num_rows, buffer_size, format, timestamp_channel);
+        file_size = RING_FILE_DATA_OFFSET + layout.get_size ();
+        if (huge_pages)
+        {
+            file_size = (file_size + RING_FILE_HUGE_PAGE_SIZE - 1) &
+                ~((size_t)RING_FILE_HUGE_PAGE_SIZE - 1);
+        }
+    }
+    int res = map_file (file_name, create, read_only, file_size);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        close_file ();
+        return res;
+    }
+
+    if (create)
+    {
+        header->version = RING_FILE_VERSION;
+        header->board_id = board_id;
+        header->num_rows = num_rows;
+        header->buffer_size = buffer_size;
+        header->data_offset = RING_FILE_DATA_OFFSET;
+        header->head.store (0, std::memory_order_relaxed);
+        header->tail.store (0, std::memory_order_relaxed);
+        header->sample_format = (int32_t)format;
+        header->timestamp_channel = timestamp_channel;
+        // magic is the last one, file without it is not recognized
+        std::atomic_thread_fence (std::memory_order_release);
+        header->magic = RING_FILE_MAGIC;
+    }
+    else
+    {
+        bool is_valid = (header->magic == RING_FILE_MAGIC) &&
+            (header->version == RING_FILE_VERSION) && (header->num_rows > 0) &&
+            (header->buffer_size > 1) && (header->data_offset >= sizeof (struct RingFileHeader)) &&
+            ((header->sample_format == (int32_t)SampleFormat::FLOAT64) ||
+                (header->sample_format == (int32_t)SampleFormat::FLOAT32));
+        if (is_valid)
+        {
+            SampleLayout layout (header->num_rows, (size_t)header->buffer_size,
+                (SampleFormat)header->sample_format, header->timestamp_channel);
+            is_valid = (header->data_offset + layout.get_size () <= mapped_size);
+        }
+        // existing file is continued only by the same board
+        if ((is_valid) && (!read_only) &&
+            ((header->board_id != board_id) || (header->num_rows != num_rows)))
+        {
+            is_valid = false;
+        }
+        if (!is_valid)
+        {
+            close_file ();
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    data = (char *)header + header->data_offset;
+
+#ifdef __linux__
+    // only file in hugetlbfs is guaranteed to be mapped with huge pages, for other filesystems
+    // madvise succeeds but usually does nothing, so its only a hint and not reported as used
+    if (huge_pages)
+    {
+        struct statfs fs_info;
+        if ((fstatfs (fd, &fs_info) == 0) &&
+            ((unsigned long)fs_info.f_type == RING_FILE_HUGETLBFS_MAGIC))
+        {
+            huge_pages_used = true;
+        }
+#if defined(MADV_HUGEPAGE)
+        else
+        {
+            madvise (header, mapped_size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+#endif
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+#ifdef _WIN32
+int RingFile::map_file (const char *file_name, bool create, bool read_only, size_t file_size)
+{
+    HANDLE file = CreateFileA (file_name, GENERIC_READ | (read_only ? 0 : GENERIC_WRITE),
+        FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, create ? CREATE_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    file_handle = file;
+    if (!create)
+    {
+        LARGE_INTEGER size;
+        if ((!GetFileSizeEx (file, &size)) || (size.QuadPart < RING_FILE_DATA_OFFSET))
+        {
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        file_size = (size_t)size.QuadPart;
+    }
+    // mapping extends new file to file_size
+    uint64_t size64 = (uint64_t)file_size;
+    HANDLE mapping = CreateFileMappingA (file, NULL, read_only ? PAGE_READONLY : PAGE_READWRITE,
+        (DWORD)(size64 >> 32), (DWORD)(size64 & 0xFFFFFFFF), NULL);
+    if (mapping == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    mapping_handle = mapping;
+    void *addr =
+        MapViewOfFile (mapping, read_only ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, file_size);
+    if (addr == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    header = (struct RingFileHeader *)addr;
+    mapped_size = file_size;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void RingFile::close_file ()
+{
+    if (header != NULL)
+    {
+        FlushViewOfFile (header, 0);
+        UnmapViewOfFile (header);
+    }
+    if (mapping_handle != NULL)
+    {
+        CloseHandle ((HANDLE)mapping_handle);
+    }
+    if (file_handle != NULL)
+    {
+        CloseHandle ((HANDLE)file_handle);
+    }
+    header = NULL;
+    data = NULL;
+    mapped_size = 0;
+    huge_pages_used = false;
+    file_handle = NULL;
+    mapping_handle = NULL;
+}
+#else
+int RingFile::map_file (const char *file_name, bool create, bool read_only, size_t file_size)
+{
+    int flags = read_only ? O_RDONLY : O_RDWR;
+    if (create)
+    {
+        flags |= O_CREAT | O_TRUNC;
+    }
+    fd = open (file_name, flags, 0644);
+    if (fd < 0)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (create)
+    {
+        if (ftruncate (fd, (off_t)file_size) != 0)
+        {
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+    }
+    else
+    {
+        struct stat st;
+        if ((fstat (fd, &st) != 0) || (st.st_size < RING_FILE_DATA_OFFSET))
+        {
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        file_size = (size_t)st.st_size;
+    }
+    int prot = read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+    void *addr = mmap (NULL, file_size, prot, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    header = (struct RingFileHeader *)addr;
+    mapped_size = file_size;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void RingFile::close_file ()
+{
+    if (header != NULL)
+    {
+        // pages are written back by OS anyway, just dont wait for it
+        msync (header, mapped_size, MS_ASYNC);
+        munmap (header, mapped_size);
+    }
+    if (fd >= 0)
+    {
+        close (fd);
+    }
+    header = NULL;
+    data = NULL;
+    mapped_size = 0;
+    huge_pages_used = false;
+    fd = -1;
+}
+#endif
+
+uint64_t RingFile::first_valid () const
+{
+    uint64_t head = header->head.load (std::memory_order_acquire);
+    uint64_t tail = header->tail.load (std::memory_order_acquire);
+    // slot for head may be partially written, it shares memory with the oldest one
+    uint64_t oldest = (head + 1 > header->buffer_size) ? head + 1 - header->buffer_size : 0;
+    return (tail > oldest) ? tail : oldest;
+}
+
+int64_t RingFile::get_num_samples () const
+{
+    if (header == NULL)
+    {
+        return 0;
+    }
+    uint64_t head = header->head.load (std::memory_order_acquire);
+    uint64_t first = first_valid ();
+    return (head > first) ? (int64_t)(head - first) : 0;
+}
+
+int64_t RingFile::read_samples (double *data_buf, int64_t max_samples) const
+{
+    if ((header == NULL) || (data_buf == NULL) || (max_samples <= 0))
+    {
+        return 0;
+    }
+    int64_t count = get_num_samples ();
+    if (count > max_samples)
+    {
+        count = max_samples;
+    }
+    size_t buffer_size = (size_t)header->buffer_size;
+    size_t start = (size_t)(first_valid () % buffer_size);
+    size_t first_half = buffer_size - start;
+    if (first_half > (size_t)count)
+    {
+        first_half = (size_t)count;
+    }
+    size_t second_half = (size_t)count - first_half;
+    SampleLayout layout (header->num_rows, buffer_size, (SampleFormat)header->sample_format,
+        header->timestamp_channel);
+    layout.read (data, start, first_half, data_buf, (size_t)max_samples);
+    layout.read (data, 0, second_half, data_buf + first_half, (size_t)max_samples);
+    return count;
+}
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <errno.h>
+#include <thread>
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include "sample_clock.h"
+#include "timestamp.h"
+
+
+SampleClock::SampleClock ()
+{
+    monotonic_base = 0;
+    wall_base = 0.0;
+}
+
+void SampleClock::start ()
+{
+    monotonic_base = get_monotonic_ns ();
+    wall_base = ::get_timestamp ();
+}
+
+int64_t SampleClock::get_elapsed_ns ()
+{
+    return get_monotonic_ns () - monotonic_base;
+}
+
+#if defined(__linux__)
+int64_t SampleClock::get_monotonic_ns ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void SampleClock::sleep_until (int64_t offset_ns)
+{
+    int64_t deadline = monotonic_base + offset_ns;
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline / 1000000000LL);
+    ts.tv_nsec = (long)(deadline % 1000000000LL);
+    // clock_nanosleep returns error code instead of setting errno
+    while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+    }
+}
+#else
+int64_t SampleClock::get_monotonic_ns ()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+        std::chrono::steady_clock::now ().time_since_epoch ())
+        .count ();
+}
+
+void SampleClock::sleep_until (int64_t offset_ns)
+{
+    std::chrono::steady_clock::time_point deadline (
+        std::chrono::duration_cast<std::chrono::steady_clock::duration> (
+            std::chrono::nanoseconds (monotonic_base + offset_ns)));
+    std::this_thread::sleep_until (deadline);
+}
+#endif
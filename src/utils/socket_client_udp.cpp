@@ -142,6 +142,11 @@ int SocketClientUDP::set_timeout (int num_seconds)
     return (int)SocketClientUDPReturnCodes::STATUS_OK;
 }
 
+int SocketClientUDP::enable_kernel_timestamps ()
+{
+    return (int)SocketClientUDPReturnCodes::SET_OPT_ERROR;
+}
+
 int SocketClientUDP::bind ()
 {
     // for socket clients which dont call sendto before recvfrom bind should be called on client
@@ -197,6 +202,11 @@ int SocketClientUDP::recv (void *data, int size)
     return res;
 }
 
+int SocketClientUDP::recv_batch (DatagramBatch *batch)
+{
+    return batch->recv (connect_socket);
+}
+
 void SocketClientUDP::close ()
 {
     closesocket (connect_socket);
@@ -334,6 +344,22 @@ int SocketClientUDP::set_timeout (int num_seconds)
     return (int)SocketClientUDPReturnCodes::STATUS_OK;
 }
 
+int SocketClientUDP::enable_kernel_timestamps ()
+{
+    if (connect_socket < 0)
+    {
+        return (int)SocketClientUDPReturnCodes::CREATE_SOCKET_ERROR;
+    }
+#ifdef SO_TIMESTAMPNS
+    int value = 1;
+    if (setsockopt (connect_socket, SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof (value)) == 0)
+    {
+        return (int)SocketClientUDPReturnCodes::STATUS_OK;
+    }
+#endif
+    return (int)SocketClientUDPReturnCodes::SET_OPT_ERROR;
+}
+
 int SocketClientUDP::bind ()
 {
     // for socket clients which dont call sendto before recvfrom bind should be called on client
@@ -381,6 +407,11 @@ int SocketClientUDP::recv (void *data, int size)
     return res;
 }
 
+int SocketClientUDP::recv_batch (DatagramBatch *batch)
+{
+    return batch->recv (connect_socket);
+}
+
 void SocketClientUDP::close ()
 {
     ::close (connect_socket);
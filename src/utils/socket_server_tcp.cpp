@@ -1,4 +1,5 @@
 #include "socket_server_tcp.h"
+#include "timestamp.h"
 
 
 ///////////////////////////////
@@ -15,6 +16,11 @@ SocketServerTCP::SocketServerTCP (const char *local_ip, int local_port, bool rec
     strcpy (this->local_ip, local_ip);
     this->local_port = local_port;
     this->recv_all_or_nothing = recv_all_or_nothing;
+    kernel_timestamps = false;
+    recv_timestamp = 0.0;
+    buffer.resize (SOCKET_SERVER_TCP_BUFFER_SIZE);
+    head = 0;
+    tail = 0;
     server_socket = INVALID_SOCKET;
     connected_socket = INVALID_SOCKET;
     client_connected = false;
@@ -73,6 +79,11 @@ int SocketServerTCP::accept ()
     return (int)SocketServerTCPReturnCodes::STATUS_OK;
 }
 
+int SocketServerTCP::enable_kernel_timestamps ()
+{
+    return (int)SocketServerTCPReturnCodes::SET_OPT_ERROR;
+}
+
 void SocketServerTCP::accept_worker ()
 {
     int len = sizeof (client_addr);
@@ -96,45 +107,24 @@ void SocketServerTCP::accept_worker ()
     }
 }
 
-int SocketServerTCP::recv (void *data, int size)
+int SocketServerTCP::fill_buffer (int min_free)
 {
     if (connected_socket == INVALID_SOCKET)
     {
         return -1;
     }
-    int res = ::recv (connected_socket, (char *)data, size, 0);
+    prepare_buffer (min_free);
+    int res = ::recv (connected_socket, buffer.data () + tail, (int)buffer.size () - tail, 0);
     if (res == SOCKET_ERROR)
     {
         return -1;
     }
-    for (int i = 0; i < res; i++)
-    {
-        temp_buffer.push (((char *)data)[i]);
-    }
-    // before we used SO_RCVLOWAT but it didnt work well
-    // and we were not sure that it works correctly with timeout
-    if (recv_all_or_nothing)
-    {
-        if ((int)temp_buffer.size () < size)
-        {
-            return 0;
-        }
-        for (int i = 0; i < size; i++)
-        {
-            ((char *)data)[i] = temp_buffer.front ();
-            temp_buffer.pop ();
-        }
-        return size;
-    }
-    else
+    if (res > 0)
     {
-        for (int i = 0; i < res; i++)
-        {
-            ((char *)data)[i] = temp_buffer.front ();
-            temp_buffer.pop ();
-        }
-        return res;
+        recv_timestamp = get_timestamp ();
     }
+    tail += res;
+    return res;
 }
 
 void SocketServerTCP::close ()
@@ -153,6 +143,8 @@ void SocketServerTCP::close ()
         closesocket (connected_socket);
         connected_socket = INVALID_SOCKET;
     }
+    head = 0;
+    tail = 0;
     WSACleanup ();
 }
 
@@ -170,6 +162,11 @@ SocketServerTCP::SocketServerTCP (const char *local_ip, int local_port, bool rec
     strcpy (this->local_ip, local_ip);
     this->local_port = local_port;
     this->recv_all_or_nothing = recv_all_or_nothing;
+    kernel_timestamps = false;
+    recv_timestamp = 0.0;
+    buffer.resize (SOCKET_SERVER_TCP_BUFFER_SIZE);
+    head = 0;
+    tail = 0;
     server_socket = -1;
     connected_socket = -1;
     client_connected = false;
@@ -224,6 +221,16 @@ int SocketServerTCP::accept ()
     return (int)SocketServerTCPReturnCodes::STATUS_OK;
 }
 
+int SocketServerTCP::enable_kernel_timestamps ()
+{
+#ifdef SO_TIMESTAMPNS
+    kernel_timestamps = true;
+    return (int)SocketServerTCPReturnCodes::STATUS_OK;
+#else
+    return (int)SocketServerTCPReturnCodes::SET_OPT_ERROR;
+#endif
+}
+
 void SocketServerTCP::accept_worker ()
 {
     socklen_t len = (socklen_t)sizeof (client_addr);
@@ -240,50 +247,61 @@ void SocketServerTCP::accept_worker ()
         setsockopt (connected_socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
         setsockopt (connected_socket, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof (tv));
         setsockopt (connected_socket, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof (buf_size));
+#ifdef SO_TIMESTAMPNS
+        if (kernel_timestamps)
+        {
+            setsockopt (connected_socket, SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof (value));
+        }
+#endif
 
         client_connected = true;
     }
 }
 
-int SocketServerTCP::recv (void *data, int size)
+int SocketServerTCP::fill_buffer (int min_free)
 {
     if (connected_socket <= 0)
     {
         return -1;
     }
-    int res = ::recv (connected_socket, (char *)data, size, 0);
-    if (res < 0)
+    prepare_buffer (min_free);
+    struct iovec iov;
+    iov.iov_base = buffer.data () + tail;
+    iov.iov_len = buffer.size () - tail;
+    char control[CMSG_SPACE (sizeof (struct timespec))];
+    struct msghdr hdr;
+    memset (&hdr, 0, sizeof (hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    if (kernel_timestamps)
     {
-        return res;
+        hdr.msg_control = control;
+        hdr.msg_controllen = sizeof (control);
     }
-    for (int i = 0; i < res; i++)
-    {
-        temp_buffer.push (((char *)data)[i]);
-    }
-    // before we used SO_RCVLOWAT but it didnt work well
-    // and we were not sure that it works correctly with timeout
-    if (recv_all_or_nothing)
+    int res = (int)recvmsg (connected_socket, &hdr, 0);
+    if (res < 0)
     {
-        if (temp_buffer.size () < size)
-        {
-            return 0;
-        }
-        for (int i = 0; i < size; i++)
-        {
-            ((char *)data)[i] = temp_buffer.front ();
-            temp_buffer.pop ();
-        }
-        return size;
+        return res;
     }
-    else
+    if (res > 0)
     {
-        for (int i = 0; i < res; i++)
+        recv_timestamp = get_timestamp ();
+#ifdef SO_TIMESTAMPNS
+        // timestamp of the last segment in received data
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR (&hdr); cmsg != NULL;
+             cmsg = CMSG_NXTHDR (&hdr, cmsg))
         {
-            ((char *)data)[i] = temp_buffer.front ();
-            temp_buffer.pop ();
+            if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+            {
+                struct timespec ts;
+                memcpy (&ts, CMSG_DATA (cmsg), sizeof (ts));
+                recv_timestamp = (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+            }
         }
-        return res;
+#endif
     }
+    tail += res;
+    return res;
 }
 
 void SocketServerTCP::close ()
@@ -302,5 +320,77 @@ void SocketServerTCP::close ()
         ::close (connected_socket);
         connected_socket = -1;
     }
+    head = 0;
+    tail = 0;
 }
 #endif
+
+///////////////////////////////
+/////////// COMMON ////////////
+///////////////////////////////
+
+void SocketServerTCP::prepare_buffer (int min_free)
+{
+    if (head > 0)
+    {
+        if (tail > head)
+        {
+            memmove (buffer.data (), buffer.data () + head, tail - head);
+        }
+        tail -= head;
+        head = 0;
+    }
+    if ((int)buffer.size () - tail < min_free)
+    {
+        buffer.resize (tail + min_free);
+    }
+}
+
+int SocketServerTCP::recv (void *data, int size)
+{
+    int available = tail - head;
+    // before we used SO_RCVLOWAT but it didnt work well
+    // and we were not sure that it works correctly with timeout
+    if ((available == 0) || ((recv_all_or_nothing) && (available < size)))
+    {
+        int res = fill_buffer (size - available);
+        if (res < 0)
+        {
+            return res;
+        }
+        available = tail - head;
+    }
+    if (recv_all_or_nothing)
+    {
+        if (available < size)
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        size = (available < size) ? available : size;
+    }
+    memcpy (data, buffer.data () + head, size);
+    head += size;
+    return size;
+}
+
+int SocketServerTCP::recv_frames (void *data, int frame_size, int max_frames)
+{
+    int available = tail - head;
+    if (available < frame_size)
+    {
+        int res = fill_buffer (frame_size - available);
+        if (res < 0)
+        {
+            return res;
+        }
+        available = tail - head;
+    }
+    int num_frames = available / frame_size;
+    num_frames = (num_frames > max_frames) ? max_frames : num_frames;
+    memcpy (data, buffer.data () + head, (size_t)num_frames * frame_size);
+    head += num_frames * frame_size;
+    return num_frames;
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "async_streamer.h"
+#include "board.h"
+
+// measures how long board read thread spends in stream_data if streamer sometimes stalls(like
+// disk flush or full socket buffer), streamer is called directly and via AsyncStreamer, also
+// checks that a stalling streamer doesnt affect another streamer fed from the same queue and that
+// interrupt releases read thread waiting for a stuck blocking streamer
+
+
+// benchmark doesnt link board.cpp, AsyncStreamer uses only this logger from Board
+std::shared_ptr<spdlog::logger> Board::board_logger = spdlog::stderr_logger_mt ("board_logger");
+
+// writes nothing but stalls for stall_ms every stall_period packages
+class StallingStreamer : public Streamer
+{
+    int stall_period;
+    int stall_ms;
+    long long counter;
+
+public:
+    StallingStreamer (int data_len, int stall_period, int stall_ms) : Streamer (data_len)
+    {
+        this->stall_period = stall_period;
+        this->stall_ms = stall_ms;
+        counter = 0;
+    }
+
+    int init_streamer ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    void stream_data (double *data)
+    {
+        counter++;
+        if (counter % stall_period == 0)
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (stall_ms));
+        }
+    }
+};
+
+// the first streamer stalls, others dont
+AsyncStreamer *make_async (int num_rows, size_t queue_size, int stall_period, int stall_ms,
+    std::vector<StreamerOverflowPolicy> policies)
+{
+    AsyncStreamer *async_streamer = new AsyncStreamer (num_rows, queue_size);
+    for (size_t i = 0; i < policies.size (); i++)
+    {
+        int period = (i == 0) ? stall_period : INT_MAX;
+        async_streamer->add_streamer (
+            new StallingStreamer (num_rows, period, stall_ms), policies[i]);
+    }
+    return async_streamer;
+}
+
+void run (const std::string &name, Streamer *streamer, int num_rows, int sampling_rate,
+    double duration_sec)
+{
+    streamer->init_streamer ();
+    std::vector<double> package (num_rows, 0.0);
+    int num_packages = (int)(sampling_rate * duration_sec);
+    std::vector<double> durations;
+    durations.reserve (num_packages);
+    auto period = std::chrono::nanoseconds (1000000000LL / sampling_rate);
+    auto deadline = std::chrono::steady_clock::now ();
+    int late_packages = 0;
+    for (int i = 0; i < num_packages; i++)
+    {
+        deadline += period;
+        auto now = std::chrono::steady_clock::now ();
+        if (now > deadline)
+        {
+            // device would overrun its buffer here
+            late_packages++;
+        }
+        while (std::chrono::steady_clock::now () < deadline)
+        {
+        }
+        package[0] = (double)i;
+        auto start = std::chrono::steady_clock::now ();
+        streamer->stream_data (package.data ());
+        auto stop = std::chrono::steady_clock::now ();
+        durations.push_back (
+            (double)std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start).count ());
+    }
+
+    // for several streamers values are separated by '/'
+    std::string dropped = "-";
+    std::string max_depth = "-";
+    AsyncStreamer *async_streamer = dynamic_cast<AsyncStreamer *> (streamer);
+    if (async_streamer != NULL)
+    {
+        dropped = max_depth = "";
+        for (size_t i = 0; i < async_streamer->get_num_streamers (); i++)
+        {
+            std::string separator = (i == 0) ? "" : "/";
+            dropped += separator + std::to_string (async_streamer->get_num_dropped (i));
+            max_depth += separator + std::to_string (async_streamer->get_max_queue_depth (i));
+        }
+    }
+    delete streamer;
+
+    std::sort (durations.begin (), durations.end ());
+    double total = 0.0;
+    for (double d : durations)
+    {
+        total += d;
+    }
+    std::cout << std::setw (16) << name << std::fixed << std::setprecision (1) << std::setw (12)
+              << total / durations.size () / 1000.0 << std::setw (12)
+              << durations[(size_t)(durations.size () * 0.99)] / 1000.0 << std::setw (12)
+              << durations.back () / 1000.0 << std::setw (8) << late_packages << std::setw (14)
+              << max_depth << std::setw (14) << dropped << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    int sampling_rate = 2000;
+    double duration_sec = 2.0;
+    int stall_period = 500;
+    int stall_ms = 20;
+
+    std::cout << "sampling rate " << sampling_rate << " Hz, streamer stalls for " << stall_ms
+              << " ms every " << stall_period << " packages" << std::endl;
+    std::cout << std::setw (16) << "streamer" << std::setw (12) << "mean us" << std::setw (12)
+              << "p99 us" << std::setw (12) << "max us" << std::setw (8) << "late"
+              << std::setw (14) << "max queue" << std::setw (14) << "dropped" << std::endl;
+    run ("sync", new StallingStreamer (num_rows, stall_period, stall_ms), num_rows, sampling_rate,
+        duration_sec);
+    run ("async block",
+        make_async (num_rows, DEFAULT_STREAMER_QUEUE_SIZE, stall_period, stall_ms,
+            {StreamerOverflowPolicy::BLOCK}),
+        num_rows, sampling_rate, duration_sec);
+    // queue is smaller than number of packages received during a stall
+    run ("async drop 16",
+        make_async (num_rows, 16, stall_period, stall_ms, {StreamerOverflowPolicy::DROP}),
+        num_rows, sampling_rate, duration_sec);
+    run ("async block 16",
+        make_async (num_rows, 16, stall_period, stall_ms, {StreamerOverflowPolicy::BLOCK}),
+        num_rows, sampling_rate, duration_sec);
+    // the second streamer never stalls and should not lose packages
+    run ("fanout drop 16",
+        make_async (num_rows, 16, stall_period, stall_ms,
+            {StreamerOverflowPolicy::DROP, StreamerOverflowPolicy::BLOCK}),
+        num_rows, sampling_rate, duration_sec);
+    // streamer is stuck for a second like on blocked socket, interrupt is called in the middle of
+    // the stall like stop_stream does, after that its packages are dropped and read thread goes on
+    AsyncStreamer *stuck_streamer =
+        make_async (num_rows, 16, stall_period, 1000, {StreamerOverflowPolicy::BLOCK});
+    std::thread stopper ([stuck_streamer] {
+        std::this_thread::sleep_for (std::chrono::milliseconds (500));
+        stuck_streamer->interrupt ();
+    });
+    run ("stuck block 16", stuck_streamer, num_rows, sampling_rate, duration_sec);
+    stopper.join ();
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "binary_file.h"
+#include "brainflow_constants.h"
+#include "file_streamer.h"
+
+// compares csv and binary recordings: writing package by package like streamers do during
+// acquisition and reading the whole file like read_file and playback board do
+
+
+// same parsing as in read_file and playback board
+static long long read_csv (const char *file_name, int num_rows, std::vector<double> &data)
+{
+    FILE *fp = fopen (file_name, "r");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    char buf[4096];
+    long long num_samples = 0;
+    while (fgets (buf, sizeof (buf), fp) != NULL)
+    {
+        std::string csv_string (buf);
+        std::stringstream ss (csv_string);
+        std::vector<std::string> splitted;
+        std::string tmp;
+        while (getline (ss, tmp, ','))
+        {
+            splitted.push_back (tmp);
+        }
+        for (int i = 0; (i < num_rows) && (i < (int)splitted.size ()); i++)
+        {
+            data[(size_t)(num_samples % 1024) * num_rows + i] = std::stod (splitted[i]);
+        }
+        num_samples++;
+    }
+    fclose (fp);
+    return num_samples;
+}
+
+static long long get_file_size (const char *file_name)
+{
+    FILE *fp = fopen (file_name, "rb");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    fseek (fp, 0, SEEK_END);
+    long long size = (long long)ftell (fp);
+    fclose (fp);
+    return size;
+}
+
+static void print_row (const char *name, double write_sec, double read_sec, long long num_samples,
+    long long file_size, long long samples_read)
+{
+    std::cout << std::setw (8) << name << std::fixed << std::setprecision (1) << std::setw (16)
+              << write_sec * 1e9 / num_samples << std::setw (16) << read_sec * 1e9 / num_samples
+              << std::setw (12) << file_size / 1024.0 / 1024.0 << std::setw (12) << samples_read
+              << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    long long num_samples = 60000; // one minute at 1 kHz
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--samples")
+        {
+            num_samples = std::stoll (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--rows")
+        {
+            num_rows = std::stoi (argv[i + 1]);
+        }
+    }
+    const char *csv_file = "binary_file_benchmark.csv";
+    const char *binary_file = "binary_file_benchmark" BINARY_FILE_EXTENSION;
+
+    std::vector<double> package (num_rows);
+    std::vector<int32_t> channel_map (num_rows, (int32_t)BinaryChannelType::EEG);
+    channel_map[num_rows - 1] = (int32_t)BinaryChannelType::TIMESTAMP;
+    auto fill_package = [&] (long long sample) {
+        for (int i = 0; i < num_rows - 1; i++)
+        {
+            package[i] = 100.0 * sin (0.01 * sample + i);
+        }
+        package[num_rows - 1] = 1600000000.0 + sample / 1000.0;
+    };
+
+    std::cout << num_samples << " samples, " << num_rows << " rows" << std::endl;
+    std::cout << std::setw (8) << "format" << std::setw (16) << "write ns/sample" << std::setw (16)
+              << "read ns/sample" << std::setw (12) << "size MB" << std::setw (12) << "read"
+              << std::endl;
+
+    // csv, streamer closes file in destructor
+    std::chrono::duration<double> csv_write;
+    {
+        FileStreamer csv_streamer (csv_file, "w", num_rows);
+        if (csv_streamer.init_streamer () != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            std::cerr << "failed to create " << csv_file << std::endl;
+            return 1;
+        }
+        auto start = std::chrono::high_resolution_clock::now ();
+        for (long long i = 0; i < num_samples; i++)
+        {
+            fill_package (i);
+            csv_streamer.stream_data (package.data ());
+        }
+        csv_write = std::chrono::high_resolution_clock::now () - start;
+    }
+    std::vector<double> csv_data ((size_t)1024 * num_rows);
+    auto start = std::chrono::high_resolution_clock::now ();
+    long long csv_read_samples = read_csv (csv_file, num_rows, csv_data);
+    std::chrono::duration<double> csv_read = std::chrono::high_resolution_clock::now () - start;
+    print_row ("csv", csv_write.count (), csv_read.count (), num_samples,
+        get_file_size (csv_file), csv_read_samples);
+
+    // binary
+    BinaryFileWriter writer;
+    if (writer.open_file (binary_file, "w", -1, num_rows, 1000, channel_map.data ()) !=
+        (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        std::cerr << "failed to create " << binary_file << std::endl;
+        return 1;
+    }
+    start = std::chrono::high_resolution_clock::now ();
+    for (long long i = 0; i < num_samples; i++)
+    {
+        fill_package (i);
+        writer.write_sample (package.data ());
+    }
+    writer.close_file ();
+    std::chrono::duration<double> binary_write = std::chrono::high_resolution_clock::now () - start;
+    std::vector<double> binary_data ((size_t)num_samples * num_rows);
+    start = std::chrono::high_resolution_clock::now ();
+    BinaryFileReader reader;
+    long long binary_read_samples = 0;
+    if (reader.open_file (binary_file) == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        binary_read_samples = reader.read_samples (binary_data.data (), num_samples);
+    }
+    std::chrono::duration<double> binary_read = std::chrono::high_resolution_clock::now () - start;
+    print_row ("binary", binary_write.count (), binary_read.count (), num_samples,
+        get_file_size (binary_file), binary_read_samples);
+
+    // seek by timestamp uses only block index
+    double target = 1600000000.0 + num_samples / 2000.0;
+    start = std::chrono::high_resolution_clock::now ();
+    size_t block = reader.find_block (target);
+    std::chrono::duration<double> seek = std::chrono::high_resolution_clock::now () - start;
+    std::cout << "seek to middle: block " << block << " of " << reader.get_num_blocks () << " in "
+              << std::setprecision (2) << seek.count () * 1e6 << " us" << std::endl;
+
+    remove (csv_file);
+    remove (binary_file);
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "board_descriptor.h"
+#include "brainflow_boards.h"
+
+// measures cost of filling one package of synthetic board(without data generation) using json
+// lookups as read threads did before and using precompiled BoardDescriptor
+
+
+double fill_with_json (const json &board_descr, double *package, int num_packages)
+{
+    auto start = std::chrono::steady_clock::now ();
+    std::vector<int> exg_channels = board_descr["eeg_channels"];
+    for (int i = 0; i < num_packages; i++)
+    {
+        package[board_descr["package_num_channel"].get<int> ()] = (double)i;
+        for (unsigned int j = 0; j < exg_channels.size (); j++)
+        {
+            package[exg_channels[j]] = (double)j;
+        }
+        for (int channel : board_descr["accel_channels"])
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : board_descr["gyro_channels"])
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : board_descr["eda_channels"])
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : board_descr["ppg_channels"])
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : board_descr["temperature_channels"])
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : board_descr["resistance_channels"])
+        {
+            package[channel] = 1.0;
+        }
+        package[board_descr["battery_channel"].get<int> ()] = 1.0;
+        package[board_descr["timestamp_channel"].get<int> ()] = (double)i;
+        package[board_descr["marker_channel"].get<int> ()] = 0.0;
+    }
+    auto stop = std::chrono::steady_clock::now ();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start).count () /
+        num_packages;
+}
+
+double fill_with_descriptor (const BoardDescriptor &descr, double *package, int num_packages)
+{
+    auto start = std::chrono::steady_clock::now ();
+    ChannelList exg_channels = descr.eeg_channels;
+    for (int i = 0; i < num_packages; i++)
+    {
+        package[descr.package_num_channel] = (double)i;
+        for (unsigned int j = 0; j < exg_channels.size (); j++)
+        {
+            package[exg_channels[j]] = (double)j;
+        }
+        for (int channel : descr.accel_channels)
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : descr.gyro_channels)
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : descr.eda_channels)
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : descr.ppg_channels)
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : descr.temperature_channels)
+        {
+            package[channel] = 1.0;
+        }
+        for (int channel : descr.resistance_channels)
+        {
+            package[channel] = 1.0;
+        }
+        package[descr.battery_channel] = 1.0;
+        package[descr.timestamp_channel] = (double)i;
+        package[descr.marker_channel] = 0.0;
+    }
+    auto stop = std::chrono::steady_clock::now ();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start).count () /
+        num_packages;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_packages = 1000000;
+    if ((argc > 2) && (std::string (argv[1]) == "--num-packages"))
+    {
+        num_packages = std::stoi (argv[2]);
+    }
+
+    const json &board_descr = brainflow_boards_json["boards"]["-1"];
+    BoardDescriptor descr;
+    if (descr.init (board_descr) != 0)
+    {
+        std::cerr << "failed to build descriptor for synthetic board" << std::endl;
+        return 1;
+    }
+    std::vector<double> package (descr.num_rows, 0.0);
+
+    double json_ns = fill_with_json (board_descr, package.data (), num_packages);
+    double descr_ns = fill_with_descriptor (descr, package.data (), num_packages);
+    double sampling_rate = (double)descr.sampling_rate;
+
+    std::cout << "synthetic board, " << num_packages << " packages" << std::endl;
+    std::cout << std::setw (12) << "lookup" << std::setw (14) << "ns/sample" << std::setw (22)
+              << "cpu us/s at " + std::to_string (descr.sampling_rate) + " Hz" << std::endl;
+    std::cout << std::fixed << std::setprecision (1);
+    std::cout << std::setw (12) << "json" << std::setw (14) << json_ns << std::setw (22)
+              << json_ns * sampling_rate / 1000.0 << std::endl;
+    std::cout << std::setw (12) << "descriptor" << std::setw (14) << descr_ns << std::setw (22)
+              << descr_ns * sampling_rate / 1000.0 << std::endl;
+    // keep package alive so compiler doesnt throw away the loops
+    std::cout << "checksum " << package[descr.timestamp_channel] << std::endl;
+    return 0;
+}
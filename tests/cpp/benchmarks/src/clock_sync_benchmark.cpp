@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "clock_sync.h"
+
+// simulates board which sends transactions with device timestamps: device clock has skew and
+// offset, host receives transaction after minimal delay plus exponential jitter and rare stalls,
+// optionally device clock restarts in the middle like after device reset.
+// Error is difference between reconstructed and true host time of the event after minimal delay
+// is subtracted(Galea does it with time_delay from calc_delay). Compared methods:
+//   per transaction - recv time of each transaction like Galea read thread did
+//   offset at start - offset measured with the first transactions, like a one shot calc_delay,
+//                     measured again after restart
+//   ClockSync - online fit of offset and skew
+
+
+struct Errors
+{
+    std::vector<double> all;
+    double last_minute_max;
+};
+
+static void print_row (const char *name, struct Errors &errors)
+{
+    std::vector<double> &all = errors.all;
+    double total = 0.0;
+    for (double error : all)
+    {
+        total += error;
+    }
+    std::sort (all.begin (), all.end ());
+    std::cout << std::setw (16) << name << std::fixed << std::setprecision (1) << std::setw (12)
+              << total / all.size () << std::setw (12) << all[all.size () / 2] << std::setw (12)
+              << all[(size_t)(all.size () * 0.99)] << std::setw (12) << all.back ()
+              << std::setw (14) << errors.last_minute_max << std::endl;
+}
+
+static void simulate (double skew_ppm, double duration_sec, double rate, double jitter_ms,
+    double stall_probability, bool restart, unsigned int seed)
+{
+    std::mt19937 gen (seed);
+    std::exponential_distribution<double> jitter (1000.0 / jitter_ms);
+    std::uniform_real_distribution<double> uniform (0.0, 1.0);
+    double min_delay = 0.002;
+    double device_offset = 12345.678;
+    double host_start = 1700000000.0;
+
+    ClockSync clock_sync;
+    struct Errors per_transaction;
+    struct Errors start_offset;
+    struct Errors fitted;
+    per_transaction.last_minute_max = 0.0;
+    start_offset.last_minute_max = 0.0;
+    fitted.last_minute_max = 0.0;
+    double offset_at_start = 0.0;
+    int num_start_points = 5;
+    int start_point = 0;
+    double last_device_time = 0.0;
+    double add_sec = 0.0;
+
+    long long num_transactions = (long long)(duration_sec * rate);
+    for (long long i = 0; i < num_transactions; i++)
+    {
+        double true_time = i / rate;
+        double device_time = device_offset + true_time * (1.0 + skew_ppm * 1e-6);
+        if ((restart) && (true_time >= duration_sec / 2))
+        {
+            device_time -= device_offset + duration_sec / 2;
+        }
+        double delay = min_delay + jitter (gen);
+        if (uniform (gen) < stall_probability)
+        {
+            delay += 0.05 + 0.2 * uniform (gen);
+        }
+        double host_time = host_start + true_time + delay;
+
+        auto start = std::chrono::high_resolution_clock::now ();
+        clock_sync.add (device_time, host_time);
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now () - start;
+        add_sec += elapsed.count ();
+
+        if (device_time < last_device_time)
+        {
+            start_point = 0;
+            offset_at_start = 0.0;
+        }
+        last_device_time = device_time;
+        if (start_point < num_start_points)
+        {
+            offset_at_start += (host_time - device_time) / num_start_points;
+            start_point++;
+            continue;
+        }
+        double expected = host_start + true_time + min_delay;
+        double errors[3];
+        errors[0] = fabs (host_time - expected) * 1e6;
+        errors[1] = fabs (device_time + offset_at_start - expected) * 1e6;
+        errors[2] = fabs (clock_sync.to_host (device_time) - expected) * 1e6;
+        struct Errors *targets[3] = {&per_transaction, &start_offset, &fitted};
+        for (int j = 0; j < 3; j++)
+        {
+            targets[j]->all.push_back (errors[j]);
+            if ((true_time > duration_sec - 60.0) && (errors[j] > targets[j]->last_minute_max))
+            {
+                targets[j]->last_minute_max = errors[j];
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision (1) << "skew " << skew_ppm << " ppm, jitter "
+              << jitter_ms << " ms, stalls " << stall_probability * 100.0 << "%"
+              << (restart ? ", device clock restart" : "") << ": fitted skew "
+              << (1.0 / clock_sync.get_skew () - 1.0) * 1e6 << " ppm, "
+              << clock_sync.get_num_resets () << " resets, add " << add_sec * 1e9 / num_transactions
+              << " ns" << std::endl;
+    print_row ("per transaction", per_transaction);
+    print_row ("offset at start", start_offset);
+    print_row ("ClockSync", fitted);
+}
+
+int main (int argc, char *argv[])
+{
+    double duration_sec = 3600.0;
+    double rate = 50.0;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--rate")
+        {
+            rate = std::stod (argv[i + 1]);
+        }
+    }
+
+    std::cout << duration_sec / 60.0 << " min at " << rate << " Hz, absolute error in us"
+              << std::endl;
+    std::cout << std::setw (16) << "method" << std::setw (12) << "mean" << std::setw (12)
+              << "median" << std::setw (12) << "p99" << std::setw (12) << "max" << std::setw (14)
+              << "last min max" << std::endl;
+    simulate (40.0, duration_sec, rate, 1.0, 0.001, false, 1);
+    simulate (-100.0, duration_sec, rate, 5.0, 0.01, false, 2);
+    simulate (0.0, duration_sec, rate, 0.2, 0.0, false, 3);
+    simulate (40.0, duration_sec, rate, 1.0, 0.001, true, 4);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "csv_reader.h"
+
+// parses generated csv file like read_file does: previous implementation(count rows with getc,
+// fgets, stringstream and stod) vs memory mapped CSVReader with one and several threads. Values
+// are printed with %lf like write_file and file streamer do, results of parsers are compared
+
+
+// previous read_file
+static long long read_legacy (const char *file_name, std::vector<double> &data)
+{
+    FILE *fp = fopen (file_name, "r");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    char buf[4096];
+    int total_rows = 0;
+    char c;
+    for (c = getc (fp); !feof (fp); c = getc (fp))
+    {
+        if (c == '\n')
+        {
+            total_rows++;
+        }
+    }
+    fseek (fp, 0, SEEK_SET);
+    int current_row = 0;
+    while (fgets (buf, sizeof (buf), fp) != NULL)
+    {
+        std::string csv_string (buf);
+        std::stringstream ss (csv_string);
+        std::vector<std::string> splitted;
+        std::string tmp;
+        while (getline (ss, tmp, ','))
+        {
+            splitted.push_back (tmp);
+        }
+        for (int i = 0; i < (int)splitted.size (); i++)
+        {
+            data[(size_t)i * total_rows + current_row] = std::stod (splitted[i]);
+        }
+        current_row++;
+    }
+    fclose (fp);
+    return current_row;
+}
+
+static long long read_mapped (const char *file_name, int num_threads, std::vector<double> &data)
+{
+    CSVReader reader;
+    if (reader.open_file (file_name) != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return 0;
+    }
+    int64_t max_rows = (int64_t)data.size () / reader.get_num_cols ();
+    return (long long)reader.read_rows (data.data (), max_rows, true, num_threads);
+}
+
+static long long generate (const char *file_name, int num_cols, long long size_mb)
+{
+    FILE *fp = fopen (file_name, "w");
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    long long num_rows = 0;
+    long long size = 0;
+    while (size < size_mb * 1024 * 1024)
+    {
+        for (int i = 0; i < num_cols - 1; i++)
+        {
+            size += fprintf (fp, "%lf,", 100.0 * sin (0.01 * num_rows + i) * (i + 1));
+        }
+        size += fprintf (fp, "%lf\n", 1600000000.0 + num_rows / 250.0);
+        num_rows++;
+    }
+    fclose (fp);
+    return num_rows;
+}
+
+static void print_row (const char *name, double sec, long long num_rows, long long size_mb,
+    const std::vector<double> &data, const std::vector<double> &expected)
+{
+    bool same = expected.empty () || (data == expected);
+    std::cout << std::setw (14) << name << std::fixed << std::setprecision (2) << std::setw (10)
+              << sec << std::setw (12) << size_mb / sec << std::setprecision (0) << std::setw (14)
+              << num_rows / sec << std::setw (10) << (same ? "yes" : "NO") << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    long long size_mb = 1024;
+    int num_cols = 32;
+    int num_threads = 4;
+    bool legacy = true;
+    for (int i = 1; i < argc; i++)
+    {
+        if ((std::string (argv[i]) == "--size-mb") && (i + 1 < argc))
+        {
+            size_mb = std::stoll (argv[++i]);
+        }
+        else if ((std::string (argv[i]) == "--threads") && (i + 1 < argc))
+        {
+            num_threads = std::stoi (argv[++i]);
+        }
+        else if (std::string (argv[i]) == "--no-legacy")
+        {
+            legacy = false;
+        }
+    }
+    const char *file_name = "csv_reader_benchmark.csv";
+    long long num_rows = generate (file_name, num_cols, size_mb);
+    std::cout << size_mb << " MB, " << num_rows << " rows, " << num_cols << " columns"
+              << std::endl;
+    std::cout << std::setw (14) << "parser" << std::setw (10) << "sec" << std::setw (12)
+              << "MB/s" << std::setw (14) << "rows/s" << std::setw (10) << "same" << std::endl;
+
+    std::vector<double> expected;
+    if (legacy)
+    {
+        expected.resize ((size_t)num_rows * num_cols);
+        auto start = std::chrono::high_resolution_clock::now ();
+        long long rows = read_legacy (file_name, expected);
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now () - start;
+        print_row ("legacy", elapsed.count (), rows, size_mb, expected, std::vector<double> ());
+    }
+    std::vector<double> data ((size_t)num_rows * num_cols);
+    auto start = std::chrono::high_resolution_clock::now ();
+    long long rows = read_mapped (file_name, 1, data);
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now () - start;
+    print_row ("mapped", elapsed.count (), rows, size_mb, data, expected);
+
+    std::fill (data.begin (), data.end (), 0.0);
+    start = std::chrono::high_resolution_clock::now ();
+    rows = read_mapped (file_name, num_threads, data);
+    elapsed = std::chrono::high_resolution_clock::now () - start;
+    std::string name = "mapped x" + std::to_string (num_threads);
+    print_row (name.c_str (), elapsed.count (), rows, size_mb, data, expected);
+
+    remove (file_name);
+    return 0;
+}
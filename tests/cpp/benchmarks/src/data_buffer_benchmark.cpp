@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_buffer.h"
+#include "spinlock.h"
+
+// measures how long board read thread is stalled inside add_data while another thread copies the
+// whole ring buffer with get_current_data in a loop
+
+
+// previous implementation guarded by SpinLock, kept here as a baseline
+class SpinLockDataBuffer
+{
+    SpinLock lock;
+    double *data;
+    size_t buffer_size;
+    size_t first_used, first_free;
+    size_t count;
+    size_t num_samples;
+
+    size_t next (size_t index)
+    {
+        return (index + 1) % buffer_size;
+    }
+
+    void get_chunk (size_t start, size_t size, double *data_buf)
+    {
+        if (start + size < buffer_size)
+        {
+            memcpy (data_buf, data + start * num_samples, size * sizeof (double) * num_samples);
+        }
+        else
+        {
+            size_t first_half = buffer_size - start;
+            size_t second_half = size - first_half;
+            memcpy (
+                data_buf, data + start * num_samples, first_half * sizeof (double) * num_samples);
+            memcpy (data_buf + first_half * num_samples, data,
+                second_half * sizeof (double) * num_samples);
+        }
+    }
+
+public:
+    SpinLockDataBuffer (int num_samples, size_t buffer_size)
+    {
+        this->buffer_size = buffer_size;
+        this->num_samples = num_samples;
+        data = new double[buffer_size * num_samples];
+        first_free = first_used = count = 0;
+    }
+
+    ~SpinLockDataBuffer ()
+    {
+        delete[] data;
+    }
+
+    void add_data (double *value)
+    {
+        lock.lock ();
+        memcpy (data + first_free * num_samples, value, sizeof (double) * num_samples);
+        first_free = next (first_free);
+        count++;
+        if (first_free == first_used)
+        {
+            first_used = next (first_used);
+            count--;
+        }
+        lock.unlock ();
+    }
+
+    size_t get_current_data (size_t max_count, double *data_buf)
+    {
+        lock.lock ();
+        size_t result_count = std::min (max_count, count);
+        if (result_count)
+        {
+            get_chunk ((first_used + (count - result_count)) % buffer_size, result_count, data_buf);
+        }
+        lock.unlock ();
+        return result_count;
+    }
+};
+
+struct BenchmarkResult
+{
+    double mean_ns;
+    double p99_ns;
+    double max_ns;
+    double total_stall_ms;
+    long long reads;
+};
+
+template <typename Buffer>
+BenchmarkResult run_benchmark (
+    int num_rows, int sampling_rate, size_t buffer_size, double duration_sec)
+{
+    Buffer buffer (num_rows, buffer_size);
+    std::vector<double> package (num_rows, 0.0);
+    // prefill to make reader copy the whole buffer from the beginning
+    for (size_t i = 0; i < buffer_size; i++)
+    {
+        buffer.add_data (package.data ());
+    }
+
+    std::atomic<bool> keep_alive (true);
+    std::atomic<long long> reads (0);
+    std::thread reader ([&] {
+        std::vector<double> out (buffer_size * num_rows);
+        while (keep_alive)
+        {
+            buffer.get_current_data (buffer_size, out.data ());
+            reads++;
+        }
+    });
+
+    int num_packages = (int)(sampling_rate * duration_sec);
+    std::vector<double> durations;
+    durations.reserve (num_packages);
+    auto period = std::chrono::nanoseconds (1000000000LL / sampling_rate);
+    auto deadline = std::chrono::steady_clock::now ();
+    for (int i = 0; i < num_packages; i++)
+    {
+        deadline += period;
+        while (std::chrono::steady_clock::now () < deadline)
+        {
+        }
+        package[0] = (double)i;
+        auto start = std::chrono::steady_clock::now ();
+        buffer.add_data (package.data ());
+        auto stop = std::chrono::steady_clock::now ();
+        durations.push_back (
+            (double)std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start).count ());
+    }
+    keep_alive = false;
+    reader.join ();
+
+    BenchmarkResult result;
+    double total = 0.0;
+    for (double d : durations)
+    {
+        total += d;
+    }
+    std::sort (durations.begin (), durations.end ());
+    result.mean_ns = total / durations.size ();
+    result.p99_ns = durations[(size_t)(durations.size () * 0.99)];
+    result.max_ns = durations.back ();
+    result.total_stall_ms = total / 1000000.0;
+    result.reads = reads;
+    return result;
+}
+
+void print_result (const std::string &name, int num_rows, const BenchmarkResult &result)
+{
+    std::cout << std::setw (10) << name << std::setw (8) << num_rows << std::setw (14)
+              << std::fixed << std::setprecision (0) << result.mean_ns << std::setw (14)
+              << result.p99_ns << std::setw (14) << result.max_ns << std::setw (16)
+              << std::setprecision (3) << result.total_stall_ms << std::setw (10) << result.reads
+              << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int sampling_rate = 4000;
+    size_t buffer_size = 45000;
+    double duration_sec = 2.0;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--sampling-rate")
+        {
+            sampling_rate = std::stoi (argv[++i]);
+        }
+        else if (std::string (argv[i]) == "--buffer-size")
+        {
+            buffer_size = (size_t)std::stoul (argv[++i]);
+        }
+        else if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[++i]);
+        }
+    }
+
+    std::cout << "sampling rate " << sampling_rate << " Hz, buffer size " << buffer_size
+              << " samples, reader copies the whole buffer in a loop" << std::endl;
+    std::cout << std::setw (10) << "buffer" << std::setw (8) << "rows" << std::setw (14)
+              << "mean ns" << std::setw (14) << "p99 ns" << std::setw (14) << "max ns"
+              << std::setw (16) << "total stall ms" << std::setw (10) << "reads" << std::endl;
+    int rows[] = {16, 32, 64};
+    for (int num_rows : rows)
+    {
+        print_result ("spinlock", num_rows,
+            run_benchmark<SpinLockDataBuffer> (
+                num_rows, sampling_rate, buffer_size, duration_sec));
+        print_result ("lockfree", num_rows,
+            run_benchmark<DataBuffer> (num_rows, sampling_rate, buffer_size, duration_sec));
+    }
+    return 0;
+}
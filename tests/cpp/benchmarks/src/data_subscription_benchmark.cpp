@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_subscription.h"
+
+// measures delay between push in read thread and the moment callback gets the sample for
+// different batch sizes, cost of push for read thread and lag counters with too slow callback
+
+
+static double now_us ()
+{
+    return std::chrono::duration<double, std::micro> (
+        std::chrono::steady_clock::now ().time_since_epoch ())
+        .count ();
+}
+
+struct CallbackStats
+{
+    std::vector<double> latencies;
+    long long batches;
+    int sleep_us;
+};
+
+// the first channel holds time when sample was pushed, batch is channel-major
+static void on_data (double *data, int num_rows, int num_samples, void *user_data)
+{
+    (void)num_rows;
+    struct CallbackStats *stats = (struct CallbackStats *)user_data;
+    double received = now_us ();
+    for (int i = 0; i < num_samples; i++)
+    {
+        stats->latencies.push_back (received - data[i]);
+    }
+    stats->batches++;
+    if (stats->sleep_us > 0)
+    {
+        std::this_thread::sleep_for (std::chrono::microseconds (stats->sleep_us));
+    }
+}
+
+static void run (const char *name, int batch_size, int max_delay_ms, int num_rows,
+    int sampling_rate, double duration_sec)
+{
+    struct CallbackStats stats;
+    stats.batches = 0;
+    stats.sleep_us = 0;
+    stats.latencies.reserve ((size_t)(sampling_rate * duration_sec) + 1);
+    long long num_packages = (long long)(sampling_rate * duration_sec);
+    {
+        DataSubscription subscription (num_rows, on_data, &stats, batch_size, max_delay_ms);
+        subscription.start ();
+        std::vector<double> package (num_rows, 0.0);
+        auto interval = std::chrono::microseconds (1000000 / sampling_rate);
+        auto next = std::chrono::steady_clock::now ();
+        for (long long i = 0; i < num_packages; i++)
+        {
+            next += interval;
+            std::this_thread::sleep_until (next);
+            package[0] = now_us ();
+            subscription.push (package.data ());
+        }
+        // destructor delivers the rest
+    }
+
+    std::sort (stats.latencies.begin (), stats.latencies.end ());
+    double total = 0.0;
+    for (double latency : stats.latencies)
+    {
+        total += latency;
+    }
+    std::cout << std::setw (16) << name << std::fixed << std::setprecision (1) << std::setw (12)
+              << total / stats.latencies.size () << std::setw (12)
+              << stats.latencies[stats.latencies.size () / 2] << std::setw (12)
+              << stats.latencies[(size_t)(stats.latencies.size () * 0.99)] << std::setw (12)
+              << stats.latencies.size () << std::setw (10) << stats.batches << std::endl;
+}
+
+// dispatcher waits for complete batches, producer wakes it up once per batch
+static void producer_cost (int num_rows)
+{
+    struct CallbackStats stats;
+    stats.batches = 0;
+    stats.sleep_us = 0;
+    int iterations = 2000000;
+    stats.latencies.reserve (iterations);
+    DataSubscription subscription (num_rows, on_data, &stats, 64, 0);
+    subscription.start ();
+    std::vector<double> package (num_rows, 1.0);
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < iterations; i++)
+    {
+        package[0] = now_us ();
+        subscription.push (package.data ());
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::high_resolution_clock::now () - start;
+    std::cout << "push with one subscriber: " << std::setprecision (1)
+              << elapsed.count () / iterations << " ns, dropped "
+              << subscription.get_num_dropped () << std::endl;
+}
+
+// callback needs 2 ms for each batch of 8 packages, at 10 kHz queue overflows
+static void slow_callback (int num_rows)
+{
+    struct CallbackStats stats;
+    stats.batches = 0;
+    stats.sleep_us = 2000;
+    DataSubscription subscription (num_rows, on_data, &stats, 8, 0);
+    subscription.start ();
+    std::vector<double> package (num_rows, 1.0);
+    auto interval = std::chrono::microseconds (100);
+    auto next = std::chrono::steady_clock::now ();
+    for (int i = 0; i < 20000; i++)
+    {
+        next += interval;
+        std::this_thread::sleep_until (next);
+        package[0] = now_us ();
+        subscription.push (package.data ());
+    }
+    std::cout << "slow callback: lag " << subscription.get_lag () << ", max lag "
+              << subscription.get_max_lag () << ", dropped " << subscription.get_num_dropped ()
+              << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    int sampling_rate = 1000;
+    double duration_sec = 3.0;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--rate")
+        {
+            sampling_rate = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+    }
+
+    std::cout << "sampling rate " << sampling_rate << " Hz, latency in us" << std::endl;
+    std::cout << std::setw (16) << "subscription" << std::setw (12) << "mean" << std::setw (12)
+              << "median" << std::setw (12) << "p99" << std::setw (12) << "samples"
+              << std::setw (10) << "batches" << std::endl;
+    run ("batch 1", 1, 0, num_rows, sampling_rate, duration_sec);
+    run ("batch 32", 32, 0, num_rows, sampling_rate, duration_sec);
+    run ("batch 32, 5 ms", 32, 5, num_rows, sampling_rate, duration_sec);
+    producer_cost (num_rows);
+    slow_callback (num_rows);
+    return 0;
+}
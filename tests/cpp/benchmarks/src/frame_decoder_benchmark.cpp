@@ -0,0 +1,273 @@
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "frame_decoder.h"
+#include "os_serial.h"
+
+// fake device writes cyton or freeeeg32 packages to master side of pty, reader opens slave side
+// with OSSerial like boards do and decodes packages with old read loops(one byte to find start
+// byte and then the rest for cyton, byte by byte for freeeeg32) or with FrameDecoder. Number of
+// reads is number of read syscalls, corrupted streams have a random byte dropped in 1% of packages
+
+#define START_BYTE 0xA0
+#define END_BYTE 0xC0
+#define CYTON_PACKAGE_SIZE 33
+#define FREEEEG32_PACKAGE_SIZE 99
+
+
+class CountingSerial : public OSSerial
+{
+public:
+    long long num_reads;
+
+    CountingSerial (const char *port_name) : OSSerial (port_name)
+    {
+        num_reads = 0;
+    }
+
+    int read_from_serial_port (void *bytes_to_read, int size)
+    {
+        num_reads++;
+        return OSSerial::read_from_serial_port (bytes_to_read, size);
+    }
+};
+
+struct Stats
+{
+    long long packages;
+    long long checksum;
+};
+
+// payload never contains end byte followed by start byte
+static std::vector<unsigned char> make_stream (int package_size, int num_packages, bool corrupt)
+{
+    std::vector<unsigned char> stream;
+    stream.reserve ((size_t)package_size * num_packages);
+    unsigned int seed = 42;
+    std::vector<unsigned char> package (package_size);
+    for (int i = 0; i < num_packages; i++)
+    {
+        package[0] = START_BYTE;
+        package[1] = (unsigned char)i;
+        for (int j = 2; j < package_size - 1; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            package[j] = (unsigned char)(seed >> 16);
+            if ((package[j] == START_BYTE) && (package[j - 1] == END_BYTE))
+            {
+                package[j] = 0;
+            }
+        }
+        package[package_size - 1] = END_BYTE;
+        int dropped = -1;
+        if (corrupt)
+        {
+            seed = seed * 1103515245 + 12345;
+            if ((seed >> 16) % 100 == 0)
+            {
+                dropped = (int)((seed >> 8) % package_size);
+            }
+        }
+        for (int j = 0; j < package_size; j++)
+        {
+            if (j != dropped)
+            {
+                stream.push_back (package[j]);
+            }
+        }
+    }
+    return stream;
+}
+
+static void legacy_cyton (Serial *serial, volatile bool *keep_alive, struct Stats *stats)
+{
+    unsigned char b[32];
+    while (*keep_alive)
+    {
+        int res = serial->read_from_serial_port (b, 1);
+        if ((res != 1) || (b[0] != START_BYTE))
+        {
+            continue;
+        }
+        int remaining_bytes = 32;
+        int pos = 0;
+        while ((remaining_bytes > 0) && (*keep_alive))
+        {
+            res = serial->read_from_serial_port (b + pos, remaining_bytes);
+            remaining_bytes -= res;
+            pos += res;
+        }
+        if ((remaining_bytes > 0) || (b[31] != END_BYTE))
+        {
+            continue;
+        }
+        stats->packages++;
+        stats->checksum += b[0] + b[15];
+    }
+}
+
+static void legacy_freeeeg32 (Serial *serial, volatile bool *keep_alive, struct Stats *stats)
+{
+    constexpr int max_size = 200;
+    unsigned char b[max_size] = {0};
+    while (*keep_alive)
+    {
+        int pos = 0;
+        bool complete_package = false;
+        while ((*keep_alive) && (pos < max_size - 2))
+        {
+            int res = serial->read_from_serial_port (b + pos, 1);
+            int prev_id = (pos <= 0) ? 0 : pos - 1;
+            if ((b[pos] == START_BYTE) && (b[prev_id] == END_BYTE) &&
+                (pos >= FREEEEG32_PACKAGE_SIZE - 2))
+            {
+                complete_package = true;
+                break;
+            }
+            pos += res;
+        }
+        if (complete_package)
+        {
+            stats->packages++;
+            stats->checksum += b[0] + b[15];
+        }
+    }
+}
+
+static void buffered (Serial *serial, volatile bool *keep_alive, struct Stats *stats, int min_size,
+    int max_size)
+{
+    FrameDecoder decoder (START_BYTE, END_BYTE, END_BYTE, min_size, max_size);
+    unsigned char *b = NULL;
+    int size = 0;
+    while (*keep_alive)
+    {
+        if (decoder.read_from (serial) == 0)
+        {
+            continue;
+        }
+        FrameStatus status;
+        while ((status = decoder.next_frame (&b, &size)) != FrameStatus::NO_FRAME)
+        {
+            if (status == FrameStatus::VALID)
+            {
+                stats->packages++;
+                stats->checksum += b[0] + b[15];
+            }
+        }
+    }
+}
+
+static void run (const char *name, bool is_cyton, bool legacy, bool corrupt, int num_packages,
+    int burst)
+{
+    int package_size = is_cyton ? CYTON_PACKAGE_SIZE : FREEEEG32_PACKAGE_SIZE;
+    std::vector<unsigned char> stream = make_stream (package_size, num_packages, corrupt);
+
+    int master = posix_openpt (O_RDWR | O_NOCTTY);
+    if ((master < 0) || (grantpt (master) != 0) || (unlockpt (master) != 0))
+    {
+        std::cerr << "failed to create pty" << std::endl;
+        return;
+    }
+    CountingSerial serial (ptsname (master));
+    if ((serial.open_serial_port () != SerialExitCodes::OK) ||
+        (serial.set_serial_port_settings (100, false) != SerialExitCodes::OK))
+    {
+        std::cerr << "failed to open " << ptsname (master) << std::endl;
+        close (master);
+        return;
+    }
+
+    volatile bool keep_alive = true;
+    struct Stats stats;
+    stats.packages = 0;
+    stats.checksum = 0;
+    std::thread reader ([&] {
+        if (legacy && is_cyton)
+        {
+            legacy_cyton (&serial, &keep_alive, &stats);
+        }
+        else if (legacy)
+        {
+            legacy_freeeeg32 (&serial, &keep_alive, &stats);
+        }
+        else if (is_cyton)
+        {
+            buffered (&serial, &keep_alive, &stats, package_size, package_size);
+        }
+        else
+        {
+            buffered (&serial, &keep_alive, &stats, package_size - 1, 200);
+        }
+    });
+
+    // device sends packages in bursts like usb dongle does, write blocks if reader is slow
+    auto start = std::chrono::high_resolution_clock::now ();
+    size_t chunk = (size_t)burst * package_size;
+    for (size_t pos = 0; pos < stream.size ();)
+    {
+        size_t len = (stream.size () - pos < chunk) ? stream.size () - pos : chunk;
+        ssize_t res = write (master, stream.data () + pos, len);
+        if (res <= 0)
+        {
+            break;
+        }
+        pos += (size_t)res;
+    }
+    // wait until reader drains pty
+    long long prev_packages = -1;
+    while (prev_packages != stats.packages)
+    {
+        prev_packages = stats.packages;
+        std::this_thread::sleep_for (std::chrono::milliseconds (150));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now () - start;
+    keep_alive = false;
+    reader.join ();
+    serial.close_serial_port ();
+    close (master);
+
+    // exclude waiting for the last timeout
+    double sec = elapsed.count () - 0.15;
+    std::cout << std::setw (24) << name << std::setw (10) << stats.packages << std::fixed
+              << std::setprecision (2) << std::setw (12) << (double)serial.num_reads / num_packages
+              << std::setprecision (0) << std::setw (14) << stats.packages / sec << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_packages = 200000;
+    int burst = 16;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--packages")
+        {
+            num_packages = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--burst")
+        {
+            burst = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << num_packages << " packages sent in bursts of " << burst << std::endl;
+    std::cout << std::setw (24) << "decoder" << std::setw (10) << "decoded" << std::setw (12)
+              << "reads/pkg" << std::setw (14) << "pkg/s" << std::endl;
+    run ("cyton legacy", true, true, false, num_packages, burst);
+    run ("cyton buffered", true, false, false, num_packages, burst);
+    run ("cyton legacy 1% bad", true, true, true, num_packages, burst);
+    run ("cyton buffered 1% bad", true, false, true, num_packages, burst);
+    run ("freeeeg32 legacy", false, true, false, num_packages / 4, burst);
+    run ("freeeeg32 buffered", false, false, false, num_packages / 4, burst);
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "datagram_batch.h"
+#include "socket_client_udp.h"
+#include "timestamp.h"
+
+// local sender plays Galea and sends datagram with its send time every interval, receiver stamps
+// datagrams like read threads did(get_timestamp after recv returns) and with kernel arrival time
+// from SO_TIMESTAMPNS. Delay is time from sendto to timestamp, jitter is its standard deviation.
+// Busy threads compete with receiver for cpu like other work in user application
+
+
+static void print_row (const char *name, std::vector<double> &delays)
+{
+    if (delays.empty ())
+    {
+        return;
+    }
+    std::sort (delays.begin (), delays.end ());
+    double mean = 0.0;
+    for (double delay : delays)
+    {
+        mean += delay;
+    }
+    mean /= delays.size ();
+    double var = 0.0;
+    for (double delay : delays)
+    {
+        var += (delay - mean) * (delay - mean);
+    }
+    double jitter = sqrt (var / delays.size ());
+    std::cout << std::setw (24) << name << std::fixed << std::setprecision (1) << std::setw (12)
+              << mean << std::setw (12) << jitter << std::setw (12)
+              << delays[(size_t)(delays.size () * 0.99)] << std::setw (12) << delays.back ()
+              << std::endl;
+}
+
+static void run (int num_busy_threads, int interval_us, int num_datagrams, int port)
+{
+    // receiver connects to sender address like Galea does to device
+    SocketClientUDP client ("127.0.0.1", port);
+    if (client.connect () != (int)SocketClientUDPReturnCodes::STATUS_OK)
+    {
+        std::cerr << "failed to create socket" << std::endl;
+        return;
+    }
+    if (client.enable_kernel_timestamps () != (int)SocketClientUDPReturnCodes::STATUS_OK)
+    {
+        std::cerr << "kernel timestamps are not supported" << std::endl;
+        return;
+    }
+    int local_port = client.get_local_port ();
+
+    std::atomic<bool> keep_busy (true);
+    std::vector<std::thread> busy_threads;
+    for (int i = 0; i < num_busy_threads; i++)
+    {
+        busy_threads.push_back (std::thread ([&keep_busy] {
+            volatile double x = 0.0;
+            while (keep_busy)
+            {
+                x = x + 1.0;
+            }
+        }));
+    }
+
+    std::thread sender ([=] {
+        int sock = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        struct sockaddr_in addr;
+        memset (&addr, 0, sizeof (addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons (port);
+        inet_pton (AF_INET, "127.0.0.1", &addr.sin_addr);
+        bind (sock, (struct sockaddr *)&addr, sizeof (addr));
+        addr.sin_port = htons (local_port);
+        struct timespec next;
+        clock_gettime (CLOCK_MONOTONIC, &next);
+        for (int i = 0; i < num_datagrams; i++)
+        {
+            next.tv_nsec += interval_us * 1000L;
+            while (next.tv_nsec >= 1000000000L)
+            {
+                next.tv_nsec -= 1000000000L;
+                next.tv_sec++;
+            }
+            clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+            double send_time = get_timestamp ();
+            sendto (sock, (const char *)&send_time, sizeof (send_time), 0,
+                (struct sockaddr *)&addr, sizeof (addr));
+        }
+        close (sock);
+    });
+
+    DatagramBatch batch (64, 16);
+    std::vector<double> user_delays;
+    std::vector<double> kernel_delays;
+    while ((int)user_delays.size () < num_datagrams)
+    {
+        int res = client.recv_batch (&batch);
+        double recv_time = get_timestamp ();
+        if (res < 0)
+        {
+            break;
+        }
+        for (int i = 0; i < res; i++)
+        {
+            double send_time;
+            memcpy (&send_time, batch.get_datagram (i), sizeof (send_time));
+            user_delays.push_back ((recv_time - send_time) * 1e6);
+            if (batch.is_kernel_timestamp (i))
+            {
+                kernel_delays.push_back ((batch.get_timestamp (i) - send_time) * 1e6);
+            }
+        }
+    }
+    sender.join ();
+    keep_busy = false;
+    for (std::thread &busy : busy_threads)
+    {
+        busy.join ();
+    }
+    client.close ();
+
+    std::cout << num_busy_threads << " busy threads" << std::endl;
+    print_row ("get_timestamp after recv", user_delays);
+    print_row ("kernel SO_TIMESTAMPNS", kernel_delays);
+}
+
+int main (int argc, char *argv[])
+{
+    int interval_us = 4000; // 250 Hz
+    int num_datagrams = 2500;
+    int port = 17995;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--interval")
+        {
+            interval_us = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--datagrams")
+        {
+            num_datagrams = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << num_datagrams << " datagrams every " << interval_us << " us, delay in us"
+              << std::endl;
+    std::cout << std::setw (24) << "timestamp" << std::setw (12) << "mean" << std::setw (12)
+              << "jitter" << std::setw (12) << "p99" << std::setw (12) << "max" << std::endl;
+    run (0, interval_us, num_datagrams, port);
+    run (1, interval_us, num_datagrams, port + 1);
+    run (2, interval_us, num_datagrams, port + 2);
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mpsc_queue.h"
+#include "spinlock.h"
+
+// measures how long read thread spends taking marker for each package while several threads
+// insert markers: previous deque under SpinLock vs lock-free MPSCQueue
+
+
+struct Marker
+{
+    double value;
+    double timestamp;
+};
+
+class SpinLockMarkers
+{
+    SpinLock lock;
+    std::deque<struct Marker> markers;
+
+public:
+    bool push (const struct Marker &marker)
+    {
+        lock.lock ();
+        markers.push_back (marker);
+        lock.unlock ();
+        return true;
+    }
+
+    bool pop (struct Marker *marker)
+    {
+        lock.lock ();
+        bool res = !markers.empty ();
+        if (res)
+        {
+            *marker = markers.front ();
+            markers.pop_front ();
+        }
+        lock.unlock ();
+        return res;
+    }
+};
+
+template <typename Queue>
+static void run (const char *name, int num_producers, int num_packages)
+{
+    Queue *queue = new Queue ();
+    std::atomic<bool> keep_alive (true);
+    std::atomic<long long> pushed (0);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < num_producers; i++)
+    {
+        producers.push_back (std::thread ([&] {
+            struct Marker marker = {1.0, 0.0};
+            while (keep_alive)
+            {
+                if (queue->push (marker))
+                {
+                    pushed++;
+                }
+            }
+        }));
+    }
+
+    std::vector<double> times;
+    times.reserve (num_packages);
+    long long popped = 0;
+    for (int i = 0; i < num_packages; i++)
+    {
+        struct Marker marker;
+        auto start = std::chrono::high_resolution_clock::now ();
+        if (queue->pop (&marker))
+        {
+            popped++;
+        }
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::high_resolution_clock::now () - start;
+        times.push_back (elapsed.count ());
+    }
+    keep_alive = false;
+    for (std::thread &producer : producers)
+    {
+        producer.join ();
+    }
+    delete queue;
+
+    std::sort (times.begin (), times.end ());
+    double total = 0.0;
+    for (double t : times)
+    {
+        total += t;
+    }
+    std::cout << std::setw (12) << name << std::fixed << std::setprecision (1) << std::setw (12)
+              << total / times.size () << std::setw (12) << times[(size_t)(times.size () * 0.99)]
+              << std::setw (14) << times.back () << std::setw (14) << popped << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_producers = 3;
+    int num_packages = 1000000;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--producers")
+        {
+            num_producers = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << num_producers << " producers, time to take marker for package in ns" << std::endl;
+    std::cout << std::setw (12) << "queue" << std::setw (12) << "mean" << std::setw (12) << "p99"
+              << std::setw (14) << "max" << std::setw (14) << "markers" << std::endl;
+    run<SpinLockMarkers> ("spinlock", num_producers, num_packages);
+    run<MPSCQueue<struct Marker, 1024>> ("mpsc", num_producers, num_packages);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_controller.h"
+#include "board_info_getter.h"
+#include "brainflow_constants.h"
+
+// several synthetic boards are polled by their own consumer threads while one more synthetic board
+// restarts streaming in a loop(stop_stream joins its thread so it's a slow call), reports latency
+// of get_board_data calls. With --global-lock all calls are wrapped in a single mutex to reproduce
+// previous behavior of board controller
+
+
+std::mutex global_lock;
+bool use_global_lock = false;
+
+template <typename Func> int call (Func func)
+{
+    if (use_global_lock)
+    {
+        std::lock_guard<std::mutex> lock (global_lock);
+        return func ();
+    }
+    return func ();
+}
+
+std::string get_params (int index)
+{
+    // boards with the same id should have different params
+    return "{\"serial_port\": \"\", \"ip_protocol\": 0, \"ip_port\": 0, \"other_info\": \"\", "
+           "\"mac_address\": \"\", \"ip_address\": \"\", \"timeout\": 0, \"serial_number\": "
+           "\"bench_" +
+        std::to_string (index) + "\", \"file\": \"\"}";
+}
+
+int main (int argc, char *argv[])
+{
+    int num_boards = 4;
+    double duration_sec = 3.0;
+    for (int i = 1; i < argc; i++)
+    {
+        if ((std::string (argv[i]) == "--num-boards") && (i + 1 < argc))
+        {
+            num_boards = std::stoi (argv[++i]);
+        }
+        else if ((std::string (argv[i]) == "--duration") && (i + 1 < argc))
+        {
+            duration_sec = std::stod (argv[++i]);
+        }
+        else if (std::string (argv[i]) == "--global-lock")
+        {
+            use_global_lock = true;
+        }
+    }
+    set_log_level ((int)LogLevels::LEVEL_OFF);
+
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    int num_rows = 0;
+    get_num_rows (board_id, &num_rows);
+    // last board is restarted in a loop
+    std::vector<int> handles (num_boards + 1, -1);
+    for (int i = 0; i <= num_boards; i++)
+    {
+        std::string params = get_params (i);
+        int res = prepare_session_handle (&handles[i], board_id, (char *)params.c_str ());
+        if (res == (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            res = start_stream_by_handle (45000, (char *)"", handles[i]);
+        }
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            std::cerr << "failed to start board " << i << ": " << res << std::endl;
+            return 1;
+        }
+    }
+
+    std::atomic<bool> keep_alive (true);
+    std::atomic<long long> restarts (0);
+    std::thread noisy ([&] {
+        while (keep_alive)
+        {
+            call ([&] { return stop_stream_by_handle (handles[num_boards]); });
+            call ([&] { return start_stream_by_handle (45000, (char *)"", handles[num_boards]); });
+            restarts++;
+        }
+    });
+
+    std::vector<std::vector<double>> latencies (num_boards);
+    std::vector<long long> samples (num_boards, 0);
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < num_boards; i++)
+    {
+        consumers.push_back (std::thread ([&, i] {
+            std::vector<double> buf (num_rows * 45000);
+            while (keep_alive)
+            {
+                auto start = std::chrono::steady_clock::now ();
+                int count = 0;
+                call ([&] { return get_board_data_count_by_handle (&count, handles[i]); });
+                call ([&] { return get_board_data_by_handle (count, buf.data (), handles[i]); });
+                auto stop = std::chrono::steady_clock::now ();
+                latencies[i].push_back (
+                    (double)std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start)
+                        .count ());
+                samples[i] += count;
+                std::this_thread::sleep_for (std::chrono::microseconds (500));
+            }
+        }));
+    }
+
+    std::this_thread::sleep_for (std::chrono::milliseconds ((int)(duration_sec * 1000)));
+    keep_alive = false;
+    for (std::thread &consumer : consumers)
+    {
+        consumer.join ();
+    }
+    noisy.join ();
+    for (int handle : handles)
+    {
+        stop_stream_by_handle (handle);
+        release_session_by_handle (handle);
+    }
+
+    std::cout << (use_global_lock ? "global lock" : "per board locks") << ", " << num_boards
+              << " consumers, " << restarts << " restarts of another board" << std::endl;
+    std::cout << std::setw (8) << "board" << std::setw (10) << "polls" << std::setw (10)
+              << "samples" << std::setw (14) << "mean us" << std::setw (14) << "p99 us"
+              << std::setw (14) << "max us" << std::endl;
+    std::cout << std::fixed << std::setprecision (1);
+    for (int i = 0; i < num_boards; i++)
+    {
+        std::vector<double> &l = latencies[i];
+        std::sort (l.begin (), l.end ());
+        double total = 0.0;
+        for (double v : l)
+        {
+            total += v;
+        }
+        std::cout << std::setw (8) << i << std::setw (10) << l.size () << std::setw (10)
+                  << samples[i] << std::setw (14) << total / l.size () / 1000.0 << std::setw (14)
+                  << l[(size_t)(l.size () * 0.99)] / 1000.0 << std::setw (14) << l.back () / 1000.0
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "multicast_client.h"
+#include "multicast_frame.h"
+#include "multicast_streamer.h"
+
+// compares old protocol(one package per datagram) with frames of several packages: number of
+// datagrams is number of sendto and recvfrom calls, bytes include udp payload only. Receiver
+// counts packages and detects lost ones using frame sequence numbers
+
+
+// benchmark doesnt link board.cpp, MultiCastStreamer uses only this logger from Board
+std::shared_ptr<spdlog::logger> Board::board_logger = spdlog::stderr_logger_mt ("board_logger");
+
+struct ReceiverStats
+{
+    std::atomic<bool> keep_alive;
+    long long datagrams;
+    long long bytes;
+    long long packages;
+    long long lost;
+};
+
+static void receive (MultiCastClient *client, int num_rows, struct ReceiverStats *stats)
+{
+    std::vector<char> datagram (MULTICAST_MAX_DATAGRAM_SIZE);
+    int package_size = (int)sizeof (double) * num_rows;
+    int header_size = (int)sizeof (struct MultiCastFrameHeader);
+    uint64_t expected_seq = 0;
+    while (stats->keep_alive)
+    {
+        int res = client->recv (datagram.data (), MULTICAST_MAX_DATAGRAM_SIZE);
+        // one byte datagram only wakes up receiver
+        if (res <= 1)
+        {
+            continue;
+        }
+        stats->datagrams++;
+        stats->bytes += res;
+        if (res == package_size)
+        {
+            stats->packages++;
+            continue;
+        }
+        struct MultiCastFrameHeader header;
+        memcpy (&header, datagram.data (), sizeof (header));
+        if ((res < header_size) || (header.magic != MULTICAST_FRAME_MAGIC))
+        {
+            continue;
+        }
+        if (header.seq > expected_seq)
+        {
+            stats->lost += (long long)(header.seq - expected_seq);
+        }
+        expected_seq = header.seq + header.num_samples;
+        stats->packages += header.num_samples;
+    }
+}
+
+static void run (const char *name, int version, int batch_size, int num_rows, int sampling_rate,
+    double duration_sec, const char *ip, int port)
+{
+    MultiCastClient client (ip, port);
+    if (client.init () != (int)MultiCastReturnCodes::STATUS_OK)
+    {
+        std::cerr << "failed to init multicast client" << std::endl;
+        return;
+    }
+    struct ReceiverStats stats;
+    stats.keep_alive = true;
+    stats.datagrams = 0;
+    stats.bytes = 0;
+    stats.packages = 0;
+    stats.lost = 0;
+    std::thread receiver (receive, &client, num_rows, &stats);
+
+    MultiCastStreamer streamer (ip, port, -1, num_rows, version, batch_size);
+    if (streamer.init_streamer () != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        std::cerr << "failed to init streamer" << std::endl;
+        stats.keep_alive = false;
+        receiver.join ();
+        return;
+    }
+    std::vector<double> package (num_rows, 1.0);
+    long long num_packages = (long long)(sampling_rate * duration_sec);
+    int packages_per_ms = sampling_rate / 1000;
+    packages_per_ms = (packages_per_ms < 1) ? 1 : packages_per_ms;
+    double send_sec = 0.0;
+    // packages come in bursts each ms like from real boards, streamer thread is idle in between
+    for (long long sent = 0; sent < num_packages;)
+    {
+        auto start = std::chrono::high_resolution_clock::now ();
+        for (int i = 0; (i < packages_per_ms) && (sent < num_packages); i++, sent++)
+        {
+            package[0] = (double)sent;
+            streamer.stream_data (package.data ());
+        }
+        streamer.on_idle ();
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now () - start;
+        send_sec += elapsed.count ();
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds (DEFAULT_MULTICAST_FLUSH_INTERVAL_MS));
+    streamer.on_idle ();
+    std::this_thread::sleep_for (std::chrono::milliseconds (200));
+    stats.keep_alive = false;
+    // receiver exits after recv timeout if nothing arrives
+    MultiCastServer wakeup (ip, port);
+    char byte = 0;
+    if (wakeup.init () == (int)MultiCastReturnCodes::STATUS_OK)
+    {
+        wakeup.send (&byte, 1);
+    }
+    receiver.join ();
+
+    std::cout << std::setw (14) << name << std::setw (12) << num_packages << std::setw (12)
+              << stats.packages << std::setw (10) << stats.lost << std::setw (12)
+              << stats.datagrams << std::fixed << std::setprecision (1) << std::setw (12)
+              << stats.bytes / duration_sec / 1024.0 << std::setw (14)
+              << send_sec * 1e9 / num_packages << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    int sampling_rate = 4000;
+    double duration_sec = 2.0;
+    const char *ip = "225.1.1.1";
+    int port = 6688;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--rate")
+        {
+            sampling_rate = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--rows")
+        {
+            num_rows = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+    }
+
+    std::cout << "sampling rate " << sampling_rate << " Hz, " << num_rows << " rows" << std::endl;
+    std::cout << std::setw (14) << "protocol" << std::setw (12) << "sent" << std::setw (12)
+              << "received" << std::setw (10) << "lost" << std::setw (12) << "datagrams"
+              << std::setw (12) << "KB/s" << std::setw (14) << "send ns/pkg" << std::endl;
+    run ("legacy", MULTICAST_LEGACY_VERSION, 1, num_rows, sampling_rate, duration_sec, ip, port);
+    run ("frame mtu", MULTICAST_FRAME_VERSION, 0, num_rows, sampling_rate, duration_sec, ip, port);
+    run ("frame 64", MULTICAST_FRAME_VERSION, 64, num_rows, sampling_rate, duration_sec, ip, port);
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#include "notion_osc_parser.h"
+
+#include <oscpp/client.hpp>
+
+// decodes /raw messages like Notion sends them: 8 eeg values, timestamp string, package number and
+// marker. Legacy decoder is a copy of NotionOSC::handle_packet before NotionOSCParser: it builds
+// std::string for address, timestamp and marker and converts them with std::stod. Allocations are
+// counted with replaced operator new, cpu time is measured with thread cpu clock
+
+
+static long long num_allocations = 0;
+
+void *operator new (size_t size)
+{
+    num_allocations++;
+    void *ptr = malloc (size ? size : 1);
+    if (ptr == NULL)
+    {
+        throw std::bad_alloc ();
+    }
+    return ptr;
+}
+
+void operator delete (void *ptr) noexcept
+{
+    free (ptr);
+}
+
+static double thread_cpu_sec ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool legacy_decode (const struct BoardDescriptor &descr, const std::string &serial_number,
+    const OSCPP::Server::Message &msg, double *package)
+{
+    std::string msg_address = std::string (msg.address ());
+    OSCPP::Server::ArgStream args (msg.args ());
+    if ((msg_address.size () > 3) &&
+        (msg_address.compare (msg_address.size () - 3, 3, "raw") == 0))
+    {
+        if (!serial_number.empty ())
+        {
+            if (msg_address.find (serial_number) == std::string::npos)
+            {
+                return false;
+            }
+        }
+        try
+        {
+            OSCPP::Server::ArgStream eeg_data (args.array ());
+            int counter = 0;
+            while (!eeg_data.atEnd ())
+            {
+                package[descr.eeg_channels[counter]] = (double)eeg_data.float32 ();
+                counter++;
+            }
+            std::string timestamp_str = args.string ();
+            package[descr.timestamp_channel] = std::stod (timestamp_str);
+            package[descr.package_num_channel] = (double)args.int32 ();
+            std::string marker = std::string (args.string ());
+            if (!marker.empty ())
+            {
+                try
+                {
+                    package[descr.other_channels[0]] = std::stod (marker);
+                }
+                catch (...)
+                {
+                }
+            }
+            return true;
+        }
+        catch (std::exception &e)
+        {
+        }
+    }
+    return false;
+}
+
+static size_t write_message (std::vector<char> &buffer, const char *address, int package_num,
+    const char *marker)
+{
+    OSCPP::Client::Packet packet (buffer.data (), buffer.size ());
+    packet.openMessage (address, 13).openArray ();
+    for (int i = 0; i < 8; i++)
+    {
+        packet.float32 (0.5f * i + package_num);
+    }
+    std::string timestamp = std::to_string (1600000000.123 + package_num * 0.004);
+    packet.closeArray ().string (timestamp.c_str ()).int32 (package_num).string (marker);
+    packet.closeMessage ();
+    return packet.size ();
+}
+
+static void run (const char *name, const char *address, const std::string &serial_number,
+    const char *marker, int num_messages)
+{
+    struct BoardDescriptor descr;
+    descr.num_rows = 13;
+    descr.package_num_channel = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        descr.eeg_channels.channels[i] = i + 1;
+    }
+    descr.eeg_channels.len = 8;
+    descr.timestamp_channel = 9;
+    descr.other_channels.channels[0] = 10;
+    descr.other_channels.len = 1;
+    double package[13] = {0.0};
+
+    // a set of different messages like consecutive datagrams
+    std::vector<std::vector<char>> messages (64, std::vector<char> (512));
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < messages.size (); i++)
+    {
+        sizes.push_back (write_message (messages[i], address, (int)i, marker));
+    }
+
+    NotionOSCParser parser (descr, serial_number);
+    long long decoded[2] = {0, 0};
+    long long allocations[2] = {0, 0};
+    double cpu_sec[2] = {0.0, 0.0};
+    double checksum[2] = {0.0, 0.0};
+    for (int method = 0; method < 2; method++)
+    {
+        long long allocations_start = num_allocations;
+        double cpu_start = thread_cpu_sec ();
+        for (int i = 0; i < num_messages; i++)
+        {
+            size_t idx = i % messages.size ();
+            OSCPP::Server::Packet packet (messages[idx].data (), sizes[idx]);
+            OSCPP::Server::Message msg (packet);
+            bool pushed;
+            if (method == 0)
+            {
+                pushed = legacy_decode (descr, serial_number, msg, package);
+            }
+            else
+            {
+                NotionOSCMessage res = parser.decode (msg, package);
+                pushed = (res == NotionOSCMessage::RAW) || (res == NotionOSCMessage::WRONG_MARKER);
+            }
+            if (pushed)
+            {
+                decoded[method]++;
+                checksum[method] += package[1] + package[9] + package[10];
+            }
+        }
+        cpu_sec[method] = thread_cpu_sec () - cpu_start;
+        allocations[method] = num_allocations - allocations_start;
+    }
+
+    const char *methods[2] = {"legacy", "NotionOSCParser"};
+    for (int method = 0; method < 2; method++)
+    {
+        std::cout << std::setw (22) << name << std::setw (18) << methods[method] << std::setw (10)
+                  << decoded[method] << std::fixed << std::setprecision (2) << std::setw (12)
+                  << (double)allocations[method] / num_messages << std::setprecision (1)
+                  << std::setw (12) << cpu_sec[method] * 1e9 / num_messages
+                  << (checksum[method] == checksum[0] ? "" : "  MISMATCH") << std::endl;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    int num_messages = 1000000;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--messages")
+        {
+            num_messages = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << num_messages << " messages" << std::endl;
+    std::cout << std::setw (22) << "message" << std::setw (18) << "decoder" << std::setw (10)
+              << "decoded" << std::setw (12) << "allocs/msg" << std::setw (12) << "ns/msg"
+              << std::endl;
+    const char *address = "/neurosity/notion/0123456789abcdef0123456789abcdef/raw";
+    run ("raw", address, "", "", num_messages);
+    run ("raw with serial", address, "0123456789abcdef0123456789abcdef", "", num_messages);
+    run ("raw with marker", address, "", "2.0", num_messages);
+    run ("other device", address, "fedcba9876543210fedcba9876543210", "", num_messages);
+    run ("other address", "/neurosity/notion/0123456789abcdef0123456789abcdef/awareness", "", "",
+        num_messages);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_controller.h"
+#include "brainflow_constants.h"
+
+// playback board as a load generator: recording is made by synthetic board, then it's replayed in
+// a loop at several speeds, reports time of prepare_session which loads file, time of the first
+// and the second start_stream in the same session and achieved samples per second
+
+
+static std::string get_params (const char *other_info, const char *file)
+{
+    return std::string ("{\"serial_port\": \"\", \"ip_protocol\": 0, \"ip_port\": 0, "
+                        "\"other_info\": \"") +
+        other_info +
+        "\", \"mac_address\": \"\", \"ip_address\": \"\", \"timeout\": 0, "
+        "\"serial_number\": \"\", \"file\": \"" +
+        file + "\"}";
+}
+
+static int record (const char *file, double duration_sec)
+{
+    std::string params = get_params ("sampling_rate=100000&batch_size=100", "");
+    std::string streamer = std::string ("file://") + file + ":w";
+    int handle = -1;
+    int res = prepare_session_handle (
+        &handle, (int)BoardIds::SYNTHETIC_BOARD, (char *)params.c_str ());
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = start_stream_by_handle (450000, (char *)streamer.c_str (), handle);
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds ((int)(duration_sec * 1000)));
+    stop_stream_by_handle (handle);
+    release_session_by_handle (handle);
+    return res;
+}
+
+static void run (const char *file, const char *speed, double duration_sec)
+{
+    std::string params = get_params ("-1&batch_size=100", file);
+    int handle = -1;
+    auto start = std::chrono::steady_clock::now ();
+    int res = prepare_session_handle (
+        &handle, (int)BoardIds::PLAYBACK_FILE_BOARD, (char *)params.c_str ());
+    std::chrono::duration<double> load = std::chrono::steady_clock::now () - start;
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        std::cerr << "failed to prepare playback: " << res << std::endl;
+        return;
+    }
+    char response[1024];
+    int response_len = 0;
+    std::string speed_config = std::string ("set_speed:") + speed;
+    config_board_by_handle ((char *)"loopback_true", response, &response_len, handle);
+    config_board_by_handle ((char *)speed_config.c_str (), response, &response_len, handle);
+
+    int num_rows = 32;
+    int max_samples = 450000;
+    std::vector<double> data ((size_t)num_rows * max_samples);
+    double start_ms[2] = {0.0, 0.0};
+    long long total = 0;
+    std::chrono::duration<double> elapsed (0.0);
+    // second stream reuses data loaded by prepare_session
+    for (int stream = 0; stream < 2; stream++)
+    {
+        start = std::chrono::steady_clock::now ();
+        res = start_stream_by_handle (max_samples, (char *)"", handle);
+        std::chrono::duration<double> started = std::chrono::steady_clock::now () - start;
+        start_ms[stream] = started.count () * 1000.0;
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            std::cerr << "failed to start playback: " << res << std::endl;
+            release_session_by_handle (handle);
+            return;
+        }
+        total = 0;
+        start = std::chrono::steady_clock::now ();
+        elapsed = std::chrono::duration<double> (0.0);
+        while (elapsed.count () < duration_sec)
+        {
+            wait_for_board_data_by_handle (1, 100, handle);
+            int count = 0;
+            get_board_data_count_by_handle (&count, handle);
+            if (count > 0)
+            {
+                get_board_data_by_handle (count, data.data (), handle);
+                total += count;
+            }
+            elapsed = std::chrono::steady_clock::now () - start;
+        }
+        stop_stream_by_handle (handle);
+    }
+    release_session_by_handle (handle);
+
+    std::cout << std::setw (12) << file << std::setw (8) << speed << std::fixed
+              << std::setprecision (1) << std::setw (12) << load.count () * 1000.0
+              << std::setw (12) << start_ms[0] << std::setw (12) << start_ms[1]
+              << std::setprecision (0) << std::setw (16) << total / elapsed.count () << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    double record_sec = 2.0;
+    double duration_sec = 2.0;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--record")
+        {
+            record_sec = std::stod (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+    }
+    set_log_level ((int)LogLevels::LEVEL_OFF);
+
+    const char *files[] = {"playback.csv", "playback.bfb"};
+    for (const char *file : files)
+    {
+        if (record (file, record_sec) != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            std::cerr << "failed to record " << file << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "recorded " << record_sec << " s at 100 kHz" << std::endl;
+    std::cout << std::setw (12) << "file" << std::setw (8) << "speed" << std::setw (12)
+              << "prepare ms" << std::setw (12) << "start 1 ms" << std::setw (12) << "start 2 ms"
+              << std::setw (16) << "samples/s" << std::endl;
+    for (const char *file : files)
+    {
+        run (file, "1", duration_sec);
+        run (file, "10", duration_sec);
+        run (file, "0", duration_sec);
+    }
+    for (const char *file : files)
+    {
+        remove (file);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_buffer.h"
+
+// several consumers need every new sample: with get_current_data each of them copies the whole
+// window and finds new samples itself, with reader cursors each one copies only new samples.
+// Measures copied samples and time spent in reading by consumers
+
+
+struct ConsumerStats
+{
+    long long copied;
+    long long received;
+    long long lost;
+    double read_sec;
+};
+
+static void consume (DataBuffer *buffer, bool use_cursor, size_t window, int poll_ms,
+    std::atomic<bool> *keep_alive, int num_rows, struct ConsumerStats *stats)
+{
+    std::vector<double> data ((size_t)num_rows * window);
+    uint64_t cursor = buffer->get_write_pos ();
+    uint64_t lost = 0;
+    double last_package = -1.0;
+    while (*keep_alive)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (poll_ms));
+        auto start = std::chrono::high_resolution_clock::now ();
+        size_t count = 0;
+        if (use_cursor)
+        {
+            count = buffer->read_since (&cursor, window, data.data (), &lost);
+            stats->received += count;
+        }
+        else
+        {
+            // first channel holds package number, new samples are after last seen one
+            count = buffer->get_current_data (window, data.data ());
+            for (size_t i = 0; i < count; i++)
+            {
+                if (data[i] > last_package)
+                {
+                    stats->received += count - i;
+                    last_package = data[count - 1];
+                    break;
+                }
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now () - start;
+        stats->read_sec += elapsed.count ();
+        stats->copied += count;
+    }
+    stats->lost = (long long)lost;
+}
+
+static void run (const char *name, bool use_cursor, int num_consumers, int num_rows,
+    int sampling_rate, double duration_sec)
+{
+    size_t window = (size_t)sampling_rate; // one second
+    DataBuffer buffer (num_rows, window * 4);
+    std::atomic<bool> keep_alive (true);
+    std::vector<struct ConsumerStats> stats (num_consumers);
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < num_consumers; i++)
+    {
+        stats[i].copied = 0;
+        stats[i].received = 0;
+        stats[i].lost = 0;
+        stats[i].read_sec = 0.0;
+        consumers.push_back (std::thread (consume, &buffer, use_cursor, window, 20 + 10 * i,
+            &keep_alive, num_rows, &stats[i]));
+    }
+
+    std::vector<double> package (num_rows, 0.0);
+    long long num_packages = (long long)(sampling_rate * duration_sec);
+    auto interval = std::chrono::microseconds (1000000 / sampling_rate);
+    auto next = std::chrono::steady_clock::now ();
+    for (long long i = 0; i < num_packages; i++)
+    {
+        next += interval;
+        std::this_thread::sleep_until (next);
+        package[0] = (double)i;
+        buffer.add_data (package.data ());
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds (100));
+    keep_alive = false;
+    for (std::thread &consumer : consumers)
+    {
+        consumer.join ();
+    }
+
+    long long copied = 0;
+    long long received = 0;
+    long long lost = 0;
+    double read_sec = 0.0;
+    for (const struct ConsumerStats &s : stats)
+    {
+        copied += s.copied;
+        received += s.received;
+        lost += s.lost;
+        read_sec += s.read_sec;
+    }
+    std::cout << std::setw (18) << name << std::setw (14) << copied << std::setw (14) << received
+              << std::setw (8) << lost << std::fixed << std::setprecision (1) << std::setw (14)
+              << read_sec * 1e3 << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    int sampling_rate = 1000;
+    double duration_sec = 3.0;
+    int num_consumers = 3;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--rate")
+        {
+            sampling_rate = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--consumers")
+        {
+            num_consumers = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << "sampling rate " << sampling_rate << " Hz, " << num_consumers
+              << " consumers, one second window" << std::endl;
+    std::cout << std::setw (18) << "consumer" << std::setw (14) << "copied" << std::setw (14)
+              << "new samples" << std::setw (8) << "lost" << std::setw (14) << "read ms"
+              << std::endl;
+    run ("get_current_data", false, num_consumers, num_rows, sampling_rate, duration_sec);
+    run ("read_since", true, num_consumers, num_rows, sampling_rate, duration_sec);
+    return 0;
+}
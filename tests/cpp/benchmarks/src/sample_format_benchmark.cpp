@@ -0,0 +1,79 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+#include "sample_format.h"
+
+// compares float64 and float32 storage: memory of ring buffer, cost of add_data for read thread,
+// cost of reading window with conversion to double and size of package in multicast frames
+
+
+static void run (const char *name, SampleFormat format, int num_rows, size_t buffer_size,
+    size_t window, int timestamp_channel)
+{
+    DataBuffer buffer (num_rows, buffer_size, format, timestamp_channel);
+    SampleLayout ring_layout (num_rows, buffer_size, format, timestamp_channel);
+    SampleLayout package_layout (num_rows, 1, format, timestamp_channel);
+    std::vector<double> package (num_rows);
+    int iterations = (int)buffer_size * 2;
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < iterations; i++)
+    {
+        for (int j = 0; j < num_rows; j++)
+        {
+            package[j] = 100.0 * sin (0.01 * i + j);
+        }
+        package[timestamp_channel] = 1600000000.0 + i / 1000.0;
+        buffer.add_data (package.data ());
+    }
+    std::chrono::duration<double, std::nano> add_time =
+        std::chrono::high_resolution_clock::now () - start;
+
+    std::vector<double> data (window * num_rows);
+    int reads = 200;
+    start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < reads; i++)
+    {
+        buffer.get_current_data (window, data.data ());
+    }
+    std::chrono::duration<double, std::nano> read_time =
+        std::chrono::high_resolution_clock::now () - start;
+
+    std::cout << std::setw (10) << name << std::fixed << std::setprecision (1) << std::setw (14)
+              << ring_layout.get_size () / 1024.0 / 1024.0 << std::setw (14)
+              << add_time.count () / iterations << std::setw (16)
+              << read_time.count () / reads / window << std::setw (12)
+              << package_layout.get_size () << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    size_t buffer_size = 450000;
+    size_t window = 10000;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--rows")
+        {
+            num_rows = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--buffer")
+        {
+            buffer_size = (size_t)std::stoll (argv[i + 1]);
+        }
+    }
+    int timestamp_channel = num_rows - 2;
+
+    std::cout << num_rows << " rows, buffer " << buffer_size << " samples, window " << window
+              << std::endl;
+    std::cout << std::setw (10) << "format" << std::setw (14) << "buffer MB" << std::setw (14)
+              << "add ns/pkg" << std::setw (16) << "read ns/sample" << std::setw (12)
+              << "pkg bytes" << std::endl;
+    run ("float64", SampleFormat::FLOAT64, num_rows, buffer_size, window, timestamp_channel);
+    run ("float32", SampleFormat::FLOAT32, num_rows, buffer_size, window, timestamp_channel);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "board_controller.h"
+#include "brainflow_constants.h"
+
+// compares cost of polling get_board_data_count with board_id and json params and with session
+// handle while synthetic board is streaming
+
+
+template <typename Func> double measure_ns (Func func, int num_calls)
+{
+    auto start = std::chrono::steady_clock::now ();
+    for (int i = 0; i < num_calls; i++)
+    {
+        if (func () != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return -1.0;
+        }
+    }
+    auto stop = std::chrono::steady_clock::now ();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start).count () /
+        num_calls;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_calls = 200000;
+    if ((argc > 2) && (std::string (argv[1]) == "--num-calls"))
+    {
+        num_calls = std::stoi (argv[2]);
+    }
+    set_log_level ((int)LogLevels::LEVEL_OFF);
+
+    char params[] = "{\"serial_port\": \"\", \"ip_protocol\": 0, \"ip_port\": 0, "
+                    "\"other_info\": \"\", \"mac_address\": \"\", \"ip_address\": \"\", "
+                    "\"timeout\": 0, \"serial_number\": \"\", \"file\": \"\"}";
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    int session_handle = -1;
+    int res = prepare_session_handle (&session_handle, board_id, params);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = start_stream (45000, (char *)"", board_id, params);
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        std::cerr << "failed to start synthetic board: " << res << std::endl;
+        return 1;
+    }
+
+    int count = 0;
+    double json_ns =
+        measure_ns ([&] { return get_board_data_count (&count, board_id, params); }, num_calls);
+    double handle_ns =
+        measure_ns ([&] { return get_board_data_count_by_handle (&count, session_handle); },
+            num_calls);
+
+    stop_stream_by_handle (session_handle);
+    release_session_by_handle (session_handle);
+
+    std::cout << "get_board_data_count, " << num_calls << " calls" << std::endl;
+    std::cout << std::fixed << std::setprecision (1);
+    std::cout << std::setw (18) << "json params" << std::setw (12) << json_ns << " ns/call"
+              << std::endl;
+    std::cout << std::setw (18) << "session handle" << std::setw (12) << handle_ns << " ns/call"
+              << std::endl;
+    return 0;
+}
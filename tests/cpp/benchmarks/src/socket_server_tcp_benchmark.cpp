@@ -0,0 +1,229 @@
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <queue>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "socket_server_tcp.h"
+
+// loopback sender plays wifi shield and sends 33 byte packages in bursts, receiver reassembles
+// packages with old std::queue<char> code, with recv of one package from SocketServerTCP and with
+// recv_frames. Receiver cpu time is measured with thread cpu clock
+
+
+#define PACKAGE_SIZE 33
+#define MAX_PACKAGES 64
+
+static double thread_cpu_sec ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void send_packages (int port, int num_packages, int burst)
+{
+    int sock = socket (AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct sockaddr_in addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons (port);
+    inet_pton (AF_INET, "127.0.0.1", &addr.sin_addr);
+    while (connect (sock, (struct sockaddr *)&addr, sizeof (addr)) != 0)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    std::vector<unsigned char> chunk ((size_t)burst * PACKAGE_SIZE);
+    for (int i = 0; i < num_packages; i += burst)
+    {
+        int count = (num_packages - i < burst) ? num_packages - i : burst;
+        for (int j = 0; j < count; j++)
+        {
+            unsigned char *package = chunk.data () + j * PACKAGE_SIZE;
+            memset (package, (i + j) & 0x7F, PACKAGE_SIZE);
+            package[0] = 0xA0;
+            package[PACKAGE_SIZE - 1] = 0xC0;
+        }
+        size_t len = (size_t)count * PACKAGE_SIZE;
+        for (size_t pos = 0; pos < len;)
+        {
+            ssize_t res = send (sock, chunk.data () + pos, len - pos, 0);
+            if (res <= 0)
+            {
+                close (sock);
+                return;
+            }
+            pos += (size_t)res;
+        }
+    }
+    close (sock);
+}
+
+// old SocketServerTCP::recv with recv_all_or_nothing
+static int legacy_recv (int sock, std::queue<char> &temp_buffer, void *data, int size)
+{
+    int res = (int)::recv (sock, (char *)data, size, 0);
+    if (res < 0)
+    {
+        return res;
+    }
+    for (int i = 0; i < res; i++)
+    {
+        temp_buffer.push (((char *)data)[i]);
+    }
+    if ((int)temp_buffer.size () < size)
+    {
+        return 0;
+    }
+    for (int i = 0; i < size; i++)
+    {
+        ((char *)data)[i] = temp_buffer.front ();
+        temp_buffer.pop ();
+    }
+    return size;
+}
+
+static bool is_valid (const unsigned char *package)
+{
+    return (package[0] == 0xA0) && (package[PACKAGE_SIZE - 1] == 0xC0);
+}
+
+static void print_row (const char *name, long long received, double wall_sec, double cpu_sec)
+{
+    std::cout << std::setw (16) << name << std::setw (10) << received << std::fixed
+              << std::setprecision (0) << std::setw (14) << received / wall_sec
+              << std::setprecision (1) << std::setw (14) << cpu_sec * 1e9 / received << std::endl;
+}
+
+static void run_legacy (int port, int num_packages, int burst)
+{
+    int server = socket (AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int value = 1;
+    setsockopt (server, SOL_SOCKET, SO_REUSEADDR, &value, sizeof (value));
+    struct sockaddr_in addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons (port);
+    inet_pton (AF_INET, "127.0.0.1", &addr.sin_addr);
+    if ((bind (server, (struct sockaddr *)&addr, sizeof (addr)) != 0) || (listen (server, 1) != 0))
+    {
+        std::cerr << "failed to bind legacy server" << std::endl;
+        close (server);
+        return;
+    }
+    std::thread sender (send_packages, port, num_packages, burst);
+    int sock = accept (server, NULL, NULL);
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 200000;
+    setsockopt (sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
+
+    std::queue<char> temp_buffer;
+    unsigned char b[PACKAGE_SIZE];
+    long long received = 0;
+    auto start = std::chrono::high_resolution_clock::now ();
+    double cpu_start = thread_cpu_sec ();
+    while (received < num_packages)
+    {
+        int res = legacy_recv (sock, temp_buffer, b, PACKAGE_SIZE);
+        if (res < 0)
+        {
+            break;
+        }
+        if ((res == PACKAGE_SIZE) && (is_valid (b)))
+        {
+            received++;
+        }
+    }
+    double cpu_sec = thread_cpu_sec () - cpu_start;
+    std::chrono::duration<double> wall = std::chrono::high_resolution_clock::now () - start;
+    sender.join ();
+    close (sock);
+    close (server);
+    print_row ("queue<char>", received, wall.count (), cpu_sec);
+}
+
+static void run (const char *name, bool frames, int port, int num_packages, int burst)
+{
+    SocketServerTCP server ("127.0.0.1", port, true);
+    if (server.bind () != (int)SocketServerTCPReturnCodes::STATUS_OK)
+    {
+        std::cerr << "failed to bind server" << std::endl;
+        return;
+    }
+    server.accept ();
+    std::thread sender (send_packages, port, num_packages, burst);
+    while (!server.client_connected)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+
+    unsigned char b[PACKAGE_SIZE * MAX_PACKAGES];
+    long long received = 0;
+    auto start = std::chrono::high_resolution_clock::now ();
+    double cpu_start = thread_cpu_sec ();
+    while (received < num_packages)
+    {
+        int res = 0;
+        if (frames)
+        {
+            res = server.recv_frames (b, PACKAGE_SIZE, MAX_PACKAGES);
+        }
+        else
+        {
+            res = (server.recv (b, PACKAGE_SIZE) == PACKAGE_SIZE) ? 1 : 0;
+        }
+        if (res < 0)
+        {
+            break;
+        }
+        for (int i = 0; i < res; i++)
+        {
+            if (is_valid (b + i * PACKAGE_SIZE))
+            {
+                received++;
+            }
+        }
+    }
+    double cpu_sec = thread_cpu_sec () - cpu_start;
+    std::chrono::duration<double> wall = std::chrono::high_resolution_clock::now () - start;
+    sender.join ();
+    server.close ();
+    print_row (name, received, wall.count (), cpu_sec);
+}
+
+int main (int argc, char *argv[])
+{
+    int num_packages = 2000000;
+    int burst = 16;
+    int port = 17982;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--packages")
+        {
+            num_packages = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--burst")
+        {
+            burst = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << num_packages << " packages of " << PACKAGE_SIZE << " bytes sent in bursts of "
+              << burst << std::endl;
+    std::cout << std::setw (16) << "receiver" << std::setw (10) << "received" << std::setw (14)
+              << "pkg/s" << std::setw (14) << "cpu ns/pkg" << std::endl;
+    run_legacy (port, num_packages, burst);
+    run ("recv", false, port + 1, num_packages, burst);
+    run ("recv_frames", true, port + 2, num_packages, burst);
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "board_controller.h"
+#include "board_info_getter.h"
+#include "brainflow_constants.h"
+#include "json.hpp"
+
+// synthetic board with other_info options as a load generator: consumer waits for data and reads
+// it like applications do, reports achieved sampling rate and channel samples per second
+
+
+using json = nlohmann::json;
+
+static void run (const char *name, std::string other_info, int num_exg, double duration_sec)
+{
+    json params = {{"serial_port", ""}, {"ip_protocol", 0}, {"ip_port", 0},
+        {"other_info", other_info}, {"mac_address", ""}, {"ip_address", ""}, {"timeout", 0},
+        {"serial_number", name}, {"file", ""}};
+    std::string params_str = params.dump ();
+    int handle = -1;
+    int res = prepare_session_handle (
+        &handle, (int)BoardIds::SYNTHETIC_BOARD, (char *)params_str.c_str ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        std::cerr << "failed to prepare " << name << ": " << res << std::endl;
+        return;
+    }
+    // rows are fixed, sampling rate depends on options
+    std::vector<char> response (64);
+    int response_len = 0;
+    config_board_by_handle ((char *)"get_sampling_rate", response.data (), &response_len, handle);
+    int sampling_rate = std::stoi (std::string (response.data (), response_len));
+    int num_rows = 0;
+    get_num_rows ((int)BoardIds::SYNTHETIC_BOARD, &num_rows);
+
+    int max_samples = 450000;
+    std::vector<double> data ((size_t)num_rows * max_samples);
+    res = start_stream_by_handle (max_samples, (char *)"", handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        std::cerr << "failed to start " << name << ": " << res << std::endl;
+        release_session_by_handle (handle);
+        return;
+    }
+    long long total = 0;
+    auto start = std::chrono::steady_clock::now ();
+    std::chrono::duration<double> elapsed (0.0);
+    while (elapsed.count () < duration_sec)
+    {
+        wait_for_board_data_by_handle (1, 100, handle);
+        int count = 0;
+        get_board_data_count_by_handle (&count, handle);
+        if (count > 0)
+        {
+            get_board_data_by_handle (count, data.data (), handle);
+            total += count;
+        }
+        elapsed = std::chrono::steady_clock::now () - start;
+    }
+    stop_stream_by_handle (handle);
+    release_session_by_handle (handle);
+
+    double rate = total / elapsed.count ();
+    std::cout << std::setw (24) << name << std::setw (8) << num_rows << std::setw (12)
+              << sampling_rate << std::fixed << std::setprecision (0) << std::setw (14) << rate
+              << std::setw (16) << rate * num_exg << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    double duration_sec = 2.0;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+    }
+    set_log_level ((int)LogLevels::LEVEL_OFF);
+
+    std::cout << std::setw (24) << "options" << std::setw (8) << "rows" << std::setw (12)
+              << "target Hz" << std::setw (14) << "achieved Hz" << std::setw (16) << "exg values/s"
+              << std::endl;
+    run ("default", "", 16, duration_sec);
+    run ("1 kHz", "sampling_rate=1000", 16, duration_sec);
+    run ("10 kHz batch 10", "sampling_rate=10000&batch_size=10", 16, duration_sec);
+    run ("100 kHz 8 ch batch 100", "sampling_rate=100000&num_channels=8&batch_size=100", 8,
+        duration_sec);
+    run ("unthrottled", "unthrottled=1&batch_size=100", 16, duration_sec);
+    run ("unthrottled 1 ch", "unthrottled=1&num_channels=1&batch_size=100", 1, duration_sec);
+    return 0;
+}
@@ -0,0 +1,223 @@
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "broadcast_client.h"
+#include "datagram_batch.h"
+
+// local blaster sends datagrams to loopback as fast as it can, receiver uses BroadCastClient like
+// NotionOSC does and calls recv per datagram or recv_batch. Receiver cpu time is measured with
+// thread cpu clock, lost datagrams are dropped by kernel when socket buffer is full. In backlog
+// mode blaster fills socket buffer while receiver waits like a read thread delayed by scheduler,
+// then receiver drains it
+
+
+static double thread_cpu_sec ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void blast (int port, int num_datagrams, int size, int pause_every)
+{
+    int sock = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons (port);
+    inet_pton (AF_INET, "127.0.0.1", &addr.sin_addr);
+    std::vector<char> datagram (size, 0);
+    for (int i = 0; i < num_datagrams; i++)
+    {
+        memcpy (datagram.data (), &i, sizeof (i));
+        sendto (sock, datagram.data (), size, 0, (struct sockaddr *)&addr, sizeof (addr));
+        // lets receiver run on machines with few cores
+        if ((pause_every > 0) && (i % pause_every == pause_every - 1))
+        {
+            std::this_thread::sleep_for (std::chrono::microseconds (200));
+        }
+    }
+    // one byte datagrams stop receiver
+    char stop = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (10));
+        sendto (sock, &stop, 1, 0, (struct sockaddr *)&addr, sizeof (addr));
+    }
+    close (sock);
+}
+
+static void run (const char *name, bool batched, int port, int num_datagrams, int size,
+    int pause_every)
+{
+    BroadCastClient client (port);
+    if (client.init () != (int)BroadCastClientReturnCodes::STATUS_OK)
+    {
+        std::cerr << "failed to init client" << std::endl;
+        return;
+    }
+    std::vector<char> datagram (size);
+    DatagramBatch batch (size, DATAGRAM_BATCH_DEFAULT_SIZE);
+    long long received = 0;
+    long long calls = 0;
+
+    std::thread sender (blast, port, num_datagrams, size, pause_every);
+    auto start = std::chrono::high_resolution_clock::now ();
+    double cpu_start = thread_cpu_sec ();
+    bool stop = false;
+    while (!stop)
+    {
+        calls++;
+        if (batched)
+        {
+            int res = client.recv_batch (&batch);
+            if (res < 0)
+            {
+                break;
+            }
+            for (int i = 0; i < res; i++)
+            {
+                if (batch.get_size (i) == 1)
+                {
+                    stop = true;
+                    break;
+                }
+                received++;
+            }
+        }
+        else
+        {
+            int res = client.recv (datagram.data (), size);
+            if (res <= 1)
+            {
+                break;
+            }
+            received++;
+        }
+    }
+    double cpu_sec = thread_cpu_sec () - cpu_start;
+    std::chrono::duration<double> wall = std::chrono::high_resolution_clock::now () - start;
+    sender.join ();
+    client.close ();
+
+    std::cout << std::setw (12) << name << std::setw (10) << received << std::setw (10)
+              << num_datagrams - received << std::fixed << std::setprecision (2) << std::setw (14)
+              << (double)received / calls << std::setprecision (0) << std::setw (12)
+              << received / wall.count () << std::setprecision (1) << std::setw (14)
+              << cpu_sec * 1e9 / received << std::endl;
+}
+
+static void run_backlog (const char *name, bool batched, int port, int rounds, int backlog,
+    int size)
+{
+    BroadCastClient client (port);
+    if (client.init () != (int)BroadCastClientReturnCodes::STATUS_OK)
+    {
+        std::cerr << "failed to init client" << std::endl;
+        return;
+    }
+    std::vector<char> datagram (size);
+    DatagramBatch batch (size, DATAGRAM_BATCH_DEFAULT_SIZE);
+    std::atomic<int> filled_rounds (0);
+    std::atomic<int> drained_rounds (0);
+    std::thread sender ([&] {
+        int sock = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        struct sockaddr_in addr;
+        memset (&addr, 0, sizeof (addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons (port);
+        inet_pton (AF_INET, "127.0.0.1", &addr.sin_addr);
+        std::vector<char> out (size, 0);
+        for (int round = 0; round < rounds; round++)
+        {
+            while (drained_rounds < round)
+            {
+                std::this_thread::yield ();
+            }
+            for (int i = 0; i < backlog; i++)
+            {
+                sendto (sock, out.data (), size, 0, (struct sockaddr *)&addr, sizeof (addr));
+            }
+            filled_rounds++;
+        }
+        close (sock);
+    });
+
+    long long received = 0;
+    long long calls = 0;
+    double cpu_sec = 0.0;
+    for (int round = 0; round < rounds; round++)
+    {
+        while (filled_rounds <= round)
+        {
+            std::this_thread::yield ();
+        }
+        double cpu_start = thread_cpu_sec ();
+        for (int count = 0; count < backlog;)
+        {
+            calls++;
+            int res = batched ? client.recv_batch (&batch) : client.recv (datagram.data (), size);
+            if (res <= 0)
+            {
+                break;
+            }
+            count += batched ? res : 1;
+            received += batched ? res : 1;
+        }
+        cpu_sec += thread_cpu_sec () - cpu_start;
+        drained_rounds++;
+    }
+    sender.join ();
+    client.close ();
+
+    std::cout << std::setw (12) << name << std::setw (10) << received << std::setw (10)
+              << (long long)rounds * backlog - received << std::fixed << std::setprecision (2)
+              << std::setw (14) << (double)received / calls << std::setw (12) << "-"
+              << std::setprecision (1) << std::setw (14) << cpu_sec * 1e9 / received << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_datagrams = 1000000;
+    int size = 200;
+    int pause_every = 64;
+    int port = 17993;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--datagrams")
+        {
+            num_datagrams = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--size")
+        {
+            size = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--pause-every")
+        {
+            pause_every = std::stoi (argv[i + 1]);
+        }
+    }
+
+    std::cout << num_datagrams << " datagrams of " << size << " bytes, sender pauses every "
+              << pause_every << std::endl;
+    std::cout << std::setw (12) << "receiver" << std::setw (10) << "received" << std::setw (10)
+              << "lost" << std::setw (14) << "dgrams/call" << std::setw (12) << "dgrams/s"
+              << std::setw (14) << "cpu ns/dgram" << std::endl;
+    run ("recv", false, port, num_datagrams, size, pause_every);
+    run ("recv_batch", true, port + 1, num_datagrams, size, pause_every);
+    std::cout << "backlog of 64 datagrams" << std::endl;
+    run_backlog ("recv", false, port + 2, num_datagrams / 64, 64, size);
+    run_backlog ("recv_batch", true, port + 3, num_datagrams / 64, 64, size);
+    return 0;
+}
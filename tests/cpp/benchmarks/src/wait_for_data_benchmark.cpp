@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_buffer.h"
+
+// measures delay between add_data and the moment consumer gets the sample: consumer waits with
+// wait_for_data or polls get_data_count with sleep like get_data_demo does, also measures cost of
+// add_data for producer without waiters
+
+
+static double now_us ()
+{
+    return std::chrono::duration<double, std::micro> (
+        std::chrono::steady_clock::now ().time_since_epoch ())
+        .count ();
+}
+
+// the first channel holds time when sample was added
+static void run (const char *name, int poll_interval_us, int num_rows, int sampling_rate,
+    double duration_sec)
+{
+    DataBuffer buffer (num_rows, 45000);
+    std::atomic<bool> keep_alive (true);
+    std::vector<double> latencies;
+    latencies.reserve ((size_t)(sampling_rate * duration_sec) + 1);
+
+    std::thread consumer ([&] {
+        std::vector<double> data ((size_t)num_rows * 45000);
+        while (keep_alive)
+        {
+            if (poll_interval_us > 0)
+            {
+                if (buffer.get_data_count () == 0)
+                {
+                    std::this_thread::sleep_for (std::chrono::microseconds (poll_interval_us));
+                    continue;
+                }
+            }
+            else if (buffer.wait_for_data (1, 100) == 0)
+            {
+                continue;
+            }
+            double received = now_us ();
+            // like bindings, request available count, rows have stride of requested count
+            size_t count = buffer.get_data_count ();
+            count = buffer.get_data ((count < 45000) ? count : 45000, data.data ());
+            for (size_t i = 0; i < count; i++)
+            {
+                latencies.push_back (received - data[i]);
+            }
+        }
+    });
+
+    std::vector<double> package (num_rows, 0.0);
+    long long num_packages = (long long)(sampling_rate * duration_sec);
+    auto interval = std::chrono::microseconds (1000000 / sampling_rate);
+    auto next = std::chrono::steady_clock::now ();
+    for (long long i = 0; i < num_packages; i++)
+    {
+        next += interval;
+        std::this_thread::sleep_until (next);
+        package[0] = now_us ();
+        buffer.add_data (package.data ());
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    keep_alive = false;
+    buffer.close ();
+    consumer.join ();
+
+    std::sort (latencies.begin (), latencies.end ());
+    double total = 0.0;
+    for (double latency : latencies)
+    {
+        total += latency;
+    }
+    std::cout << std::setw (16) << name << std::fixed << std::setprecision (1) << std::setw (12)
+              << total / latencies.size () << std::setw (12)
+              << latencies[latencies.size () / 2] << std::setw (12)
+              << latencies[(size_t)(latencies.size () * 0.99)] << std::setw (12)
+              << latencies.size () << std::endl;
+}
+
+// add_data without waiters, reader never reads so samples are overwritten
+static void producer_cost (int num_rows)
+{
+    DataBuffer buffer (num_rows, 45000);
+    std::vector<double> package (num_rows, 1.0);
+    int iterations = 2000000;
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < iterations; i++)
+    {
+        package[0] = i;
+        buffer.add_data (package.data ());
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::high_resolution_clock::now () - start;
+    std::cout << "add_data without waiters: " << std::setprecision (1)
+              << elapsed.count () / iterations << " ns" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = 32;
+    int sampling_rate = 1000;
+    double duration_sec = 3.0;
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string (argv[i]) == "--rate")
+        {
+            sampling_rate = std::stoi (argv[i + 1]);
+        }
+        if (std::string (argv[i]) == "--duration")
+        {
+            duration_sec = std::stod (argv[i + 1]);
+        }
+    }
+
+    std::cout << "sampling rate " << sampling_rate << " Hz, latency in us" << std::endl;
+    std::cout << std::setw (16) << "consumer" << std::setw (12) << "mean" << std::setw (12)
+              << "median" << std::setw (12) << "p99" << std::setw (12) << "samples" << std::endl;
+    run ("poll 10 ms", 10000, num_rows, sampling_rate, duration_sec);
+    run ("poll 1 ms", 1000, num_rows, sampling_rate, duration_sec);
+    run ("wait_for_data", 0, num_rows, sampling_rate, duration_sec);
+    producer_cost (num_rows);
+    return 0;
+}